@@ -0,0 +1,683 @@
+// Adafruit_GFX.h - reduced host version of the Adafruit GFX core graphics class
+//
+// The drawing primitives and text rendering follow the algorithms of the original library
+// (https://github.com/adafruit/Adafruit-GFX-Library) closely, so that derived display classes
+// exercise the same virtual call paths as they do on the target.
+
+#pragma once
+
+#include "Arduino.h"
+#include "gfxfont.h"
+#include "glcdfont.c"
+
+#ifndef _swap_int16_t
+#define _swap_int16_t(a, b)                                                                        \
+    {                                                                                              \
+        int16_t t = a;                                                                             \
+        a = b;                                                                                     \
+        b = t;                                                                                     \
+    }
+#endif
+
+class Adafruit_GFX : public Print {
+  public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+        _width = WIDTH;
+        _height = HEIGHT;
+        rotation = 0;
+        cursor_y = cursor_x = 0;
+        textsize_x = textsize_y = 1;
+        textcolor = textbgcolor = 0xFFFF;
+        wrap = true;
+        _cp437 = false;
+        gfxFont = NULL;
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite(void) {
+    }
+
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) {
+        drawPixel(x, y, color);
+    }
+
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        fillRect(x, y, w, h, color);
+    }
+
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        drawFastVLine(x, y, h, color);
+    }
+
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        drawFastHLine(x, y, w, color);
+    }
+
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep) {
+            _swap_int16_t(x0, y0);
+            _swap_int16_t(x1, y1);
+        }
+        if (x0 > x1) {
+            _swap_int16_t(x0, x1);
+            _swap_int16_t(y0, y1);
+        }
+        int16_t dx = x1 - x0;
+        int16_t dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = y0 < y1 ? 1 : -1;
+        for (; x0 <= x1; x0++) {
+            if (steep) {
+                writePixel(y0, x0, color);
+            } else {
+                writePixel(x0, y0, color);
+            }
+            err -= dy;
+            if (err < 0) {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    virtual void endWrite(void) {
+    }
+
+    virtual void setRotation(uint8_t r) {
+        rotation = (r & 3);
+        switch (rotation) {
+        case 0:
+        case 2:
+            _width = WIDTH;
+            _height = HEIGHT;
+            break;
+        case 1:
+        case 3:
+            _width = HEIGHT;
+            _height = WIDTH;
+            break;
+        }
+    }
+
+    virtual void invertDisplay(bool i) {
+    }
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        startWrite();
+        writeLine(x, y, x, y + h - 1, color);
+        endWrite();
+    }
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        startWrite();
+        writeLine(x, y, x + w - 1, y, color);
+        endWrite();
+    }
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        startWrite();
+        for (int16_t i = x; i < x + w; i++) {
+            writeFastVLine(i, y, h, color);
+        }
+        endWrite();
+    }
+
+    virtual void fillScreen(uint16_t color) {
+        fillRect(0, 0, _width, _height, color);
+    }
+
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        if (x0 == x1) {
+            if (y0 > y1) {
+                _swap_int16_t(y0, y1);
+            }
+            drawFastVLine(x0, y0, y1 - y0 + 1, color);
+        } else if (y0 == y1) {
+            if (x0 > x1) {
+                _swap_int16_t(x0, x1);
+            }
+            drawFastHLine(x0, y0, x1 - x0 + 1, color);
+        } else {
+            startWrite();
+            writeLine(x0, y0, x1, y1, color);
+            endWrite();
+        }
+    }
+
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        startWrite();
+        writeFastHLine(x, y, w, color);
+        writeFastHLine(x, y + h - 1, w, color);
+        writeFastVLine(x, y, h, color);
+        writeFastVLine(x + w - 1, y, h, color);
+        endWrite();
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                    uint16_t color) {
+        int16_t byteWidth = (w + 7) / 8;
+        uint8_t b = 0;
+        startWrite();
+        for (int16_t j = 0; j < h; j++, y++) {
+            for (int16_t i = 0; i < w; i++) {
+                if (i & 7) {
+                    b <<= 1;
+                } else {
+                    b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+                }
+                if (b & 0x80) {
+                    writePixel(x + i, y, color);
+                }
+            }
+        }
+        endWrite();
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                    uint16_t color, uint16_t bg) {
+        int16_t byteWidth = (w + 7) / 8;
+        uint8_t b = 0;
+        startWrite();
+        for (int16_t j = 0; j < h; j++, y++) {
+            for (int16_t i = 0; i < w; i++) {
+                if (i & 7) {
+                    b <<= 1;
+                } else {
+                    b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+                }
+                writePixel(x + i, y, (b & 0x80) ? color : bg);
+            }
+        }
+        endWrite();
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+        drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color,
+                    uint16_t bg) {
+        drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color, bg);
+    }
+
+    void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) {
+        startWrite();
+        for (int16_t j = 0; j < h; j++, y++) {
+            for (int16_t i = 0; i < w; i++) {
+                writePixel(x + i, y, bitmap[j * w + i]);
+            }
+        }
+        endWrite();
+    }
+
+    void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+        drawRGBBitmap(x, y, (const uint16_t *)bitmap, w, h);
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                  uint8_t size) {
+        drawChar(x, y, c, color, bg, size, size);
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                  uint8_t size_x, uint8_t size_y) {
+        if (!gfxFont) {
+            if ((x >= _width) || (y >= _height) || ((x + 6 * size_x - 1) < 0) ||
+                ((y + 8 * size_y - 1) < 0)) {
+                return;
+            }
+            if (!_cp437 && (c >= 176)) {
+                c++;
+            }
+            startWrite();
+            for (int8_t i = 0; i < 5; i++) {
+                uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+                for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                    if (line & 1) {
+                        if (size_x == 1 && size_y == 1) {
+                            writePixel(x + i, y + j, color);
+                        } else {
+                            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+                        }
+                    } else if (bg != color) {
+                        if (size_x == 1 && size_y == 1) {
+                            writePixel(x + i, y + j, bg);
+                        } else {
+                            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+                        }
+                    }
+                }
+            }
+            if (bg != color) {
+                if (size_x == 1 && size_y == 1) {
+                    writeFastVLine(x + 5, y, 8, bg);
+                } else {
+                    writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+                }
+            }
+            endWrite();
+        } else {
+            c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+            GFXglyph *glyph = gfxFont->glyph + c;
+            uint8_t *bitmap = gfxFont->bitmap;
+            uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+            uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+            int8_t xo = pgm_read_byte(&glyph->xOffset), yo = pgm_read_byte(&glyph->yOffset);
+            uint8_t xx, yy, bits = 0, bit = 0;
+            int16_t xo16 = 0, yo16 = 0;
+            if (size_x > 1 || size_y > 1) {
+                xo16 = xo;
+                yo16 = yo;
+            }
+            startWrite();
+            for (yy = 0; yy < h; yy++) {
+                for (xx = 0; xx < w; xx++) {
+                    if (!(bit++ & 7)) {
+                        bits = pgm_read_byte(&bitmap[bo++]);
+                    }
+                    if (bits & 0x80) {
+                        if (size_x == 1 && size_y == 1) {
+                            writePixel(x + xo + xx, y + yo + yy, color);
+                        } else {
+                            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
+                                          size_x, size_y, color);
+                        }
+                    }
+                    bits <<= 1;
+                }
+            }
+            endWrite();
+        }
+    }
+
+    void setCursor(int16_t x, int16_t y) {
+        cursor_x = x;
+        cursor_y = y;
+    }
+
+    void setTextColor(uint16_t c) {
+        textcolor = textbgcolor = c;
+    }
+
+    void setTextColor(uint16_t c, uint16_t bg) {
+        textcolor = c;
+        textbgcolor = bg;
+    }
+
+    void setTextSize(uint8_t s) {
+        textsize_x = textsize_y = s > 0 ? s : 1;
+    }
+
+    void setTextWrap(bool w) {
+        wrap = w;
+    }
+
+    void cp437(bool x = true) {
+        _cp437 = x;
+    }
+
+    void setFont(const GFXfont *f = NULL) {
+        if (f) {
+            if (!gfxFont) {
+                cursor_y += 6;
+            }
+        } else if (gfxFont) {
+            cursor_y -= 6;
+        }
+        gfxFont = (GFXfont *)f;
+    }
+
+    void getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1,
+                       uint16_t *w, uint16_t *h) {
+        uint8_t c;
+        int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+        *x1 = x;
+        *y1 = y;
+        *w = *h = 0;
+        while ((c = *str++)) {
+            charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+        }
+        if (maxx >= minx) {
+            *x1 = minx;
+            *w = maxx - minx + 1;
+        }
+        if (maxy >= miny) {
+            *y1 = miny;
+            *h = maxy - miny + 1;
+        }
+    }
+
+    void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1,
+                       uint16_t *w, uint16_t *h) {
+        getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+    }
+
+    virtual size_t write(uint8_t c) {
+        if (!gfxFont) {
+            if (c == '\n') {
+                cursor_x = 0;
+                cursor_y += textsize_y * 8;
+            } else if (c != '\r') {
+                if (wrap && ((cursor_x + textsize_x * 6) > _width)) {
+                    cursor_x = 0;
+                    cursor_y += textsize_y * 8;
+                }
+                drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+                cursor_x += textsize_x * 6;
+            }
+        } else {
+            if (c == '\n') {
+                cursor_x = 0;
+                cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+            } else if (c != '\r') {
+                uint8_t first = pgm_read_byte(&gfxFont->first);
+                if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+                    GFXglyph *glyph = gfxFont->glyph + (c - first);
+                    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+                    if ((w > 0) && (h > 0)) {
+                        int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+                        if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+                            cursor_x = 0;
+                            cursor_y += (int16_t)textsize_y *
+                                        (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                        }
+                        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+                                 textsize_y);
+                    }
+                    cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+                }
+            }
+        }
+        return 1;
+    }
+
+    int16_t width(void) const {
+        return _width;
+    }
+
+    int16_t height(void) const {
+        return _height;
+    }
+
+    uint8_t getRotation(void) const {
+        return rotation;
+    }
+
+    int16_t getCursorX(void) const {
+        return cursor_x;
+    }
+
+    int16_t getCursorY(void) const {
+        return cursor_y;
+    }
+
+  protected:
+    void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny,
+                    int16_t *maxx, int16_t *maxy) {
+        if (gfxFont) {
+            if (c == '\n') {
+                *x = 0;
+                *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+            } else if (c != '\r') {
+                uint8_t first = pgm_read_byte(&gfxFont->first),
+                        last = pgm_read_byte(&gfxFont->last);
+                if ((c >= first) && (c <= last)) {
+                    GFXglyph *glyph = gfxFont->glyph + (c - first);
+                    uint8_t gw = pgm_read_byte(&glyph->width), gh = pgm_read_byte(&glyph->height),
+                            xa = pgm_read_byte(&glyph->xAdvance);
+                    int8_t xo = pgm_read_byte(&glyph->xOffset), yo = pgm_read_byte(&glyph->yOffset);
+                    if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+                        *x = 0;
+                        *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                    }
+                    int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y,
+                            x1 = *x + xo * tsx, y1 = *y + yo * tsy, x2 = x1 + gw * tsx - 1,
+                            y2 = y1 + gh * tsy - 1;
+                    if (x1 < *minx) {
+                        *minx = x1;
+                    }
+                    if (y1 < *miny) {
+                        *miny = y1;
+                    }
+                    if (x2 > *maxx) {
+                        *maxx = x2;
+                    }
+                    if (y2 > *maxy) {
+                        *maxy = y2;
+                    }
+                    *x += xa * tsx;
+                }
+            }
+        } else {
+            if (c == '\n') {
+                *x = 0;
+                *y += textsize_y * 8;
+            } else if (c != '\r') {
+                if (wrap && ((*x + textsize_x * 6) > _width)) {
+                    *x = 0;
+                    *y += textsize_y * 8;
+                }
+                int x2 = *x + textsize_x * 6 - 1, y2 = *y + textsize_y * 8 - 1;
+                if (x2 > *maxx) {
+                    *maxx = x2;
+                }
+                if (*x < *minx) {
+                    *minx = *x;
+                }
+                if (*y < *miny) {
+                    *miny = *y;
+                }
+                if (y2 > *maxy) {
+                    *maxy = y2;
+                }
+                *x += textsize_x * 6;
+            }
+        }
+    }
+
+    const int16_t WIDTH;
+    const int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize_x;
+    uint8_t textsize_y;
+    uint8_t rotation;
+    bool wrap;
+    bool _cp437;
+    GFXfont *gfxFont;
+};
+
+/// A GFX 1-bit canvas context for graphics
+class GFXcanvas1 : public Adafruit_GFX {
+  public:
+    GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+        uint16_t bytes = ((w + 7) / 8) * h;
+        if ((buffer = (uint8_t *)malloc(bytes))) {
+            memset(buffer, 0, bytes);
+        }
+    }
+
+    ~GFXcanvas1(void) {
+        if (buffer) {
+            free(buffer);
+        }
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer) {
+            if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+                return;
+            }
+            int16_t t;
+            switch (rotation) {
+            case 1:
+                t = x;
+                x = WIDTH - 1 - y;
+                y = t;
+                break;
+            case 2:
+                x = WIDTH - 1 - x;
+                y = HEIGHT - 1 - y;
+                break;
+            case 3:
+                t = x;
+                x = y;
+                y = HEIGHT - 1 - t;
+                break;
+            }
+            uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+            if (color) {
+                *ptr |= 0x80 >> (x & 7);
+            } else {
+                *ptr &= ~(0x80 >> (x & 7));
+            }
+        }
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        // like the original: negative heights extend upwards, a zero height draws nothing
+        if (h < 0) {
+            y += h + 1;
+            h = -h;
+        }
+        for (int16_t i = 0; i < h; i++) {
+            drawPixel(x, y + i, color);
+        }
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        if (w < 0) {
+            x += w + 1;
+            w = -w;
+        }
+        for (int16_t i = 0; i < w; i++) {
+            drawPixel(x + i, y, color);
+        }
+    }
+
+    void fillScreen(uint16_t color) {
+        if (buffer) {
+            uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
+            memset(buffer, color ? 0xFF : 0x00, bytes);
+        }
+    }
+
+    bool getPixel(int16_t x, int16_t y) const {
+        int16_t t;
+        switch (rotation) {
+        case 1:
+            t = x;
+            x = WIDTH - 1 - y;
+            y = t;
+            break;
+        case 2:
+            x = WIDTH - 1 - x;
+            y = HEIGHT - 1 - y;
+            break;
+        case 3:
+            t = x;
+            x = y;
+            y = HEIGHT - 1 - t;
+            break;
+        }
+        if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT)) {
+            return false;
+        }
+        return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+    }
+
+    uint8_t *getBuffer(void) const {
+        return buffer;
+    }
+
+  private:
+    uint8_t *buffer;
+};
+
+/// A GFX 16-bit canvas context for graphics
+class GFXcanvas16 : public Adafruit_GFX {
+  public:
+    GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+        uint32_t bytes = w * h * 2;
+        if ((buffer = (uint16_t *)malloc(bytes))) {
+            memset(buffer, 0, bytes);
+        }
+    }
+
+    ~GFXcanvas16(void) {
+        if (buffer) {
+            free(buffer);
+        }
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer) {
+            if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+                return;
+            }
+            int16_t t;
+            switch (rotation) {
+            case 1:
+                t = x;
+                x = WIDTH - 1 - y;
+                y = t;
+                break;
+            case 2:
+                x = WIDTH - 1 - x;
+                y = HEIGHT - 1 - y;
+                break;
+            case 3:
+                t = x;
+                x = y;
+                y = HEIGHT - 1 - t;
+                break;
+            }
+            buffer[x + y * WIDTH] = color;
+        }
+    }
+
+    void fillScreen(uint16_t color) {
+        if (buffer) {
+            for (uint32_t i = 0; i < (uint32_t)WIDTH * HEIGHT; i++) {
+                buffer[i] = color;
+            }
+        }
+    }
+
+    uint16_t getPixel(int16_t x, int16_t y) const {
+        if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+            return 0;
+        }
+        int16_t t;
+        switch (rotation) {
+        case 1:
+            t = x;
+            x = WIDTH - 1 - y;
+            y = t;
+            break;
+        case 2:
+            x = WIDTH - 1 - x;
+            y = HEIGHT - 1 - y;
+            break;
+        case 3:
+            t = x;
+            x = y;
+            y = HEIGHT - 1 - t;
+            break;
+        }
+        return buffer[x + y * WIDTH];
+    }
+
+    uint16_t *getBuffer(void) const {
+        return buffer;
+    }
+
+  private:
+    uint16_t *buffer;
+};
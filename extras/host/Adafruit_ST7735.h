@@ -0,0 +1,371 @@
+// Adafruit_ST7735.h - reduced host version of the Adafruit ST7735 TFT driver
+//
+// Contains the parts of Adafruit_SPITFT, Adafruit_ST77xx and Adafruit_ST7735 of the original
+// library (https://github.com/adafruit/Adafruit-ST7735-Library) that are used by mupplet-display.
+// The bus traffic follows the original: chip select and data/command lines are driven by
+// `digitalWrite()`, commands and pixel data are sent by `SPI.transfer()`, so that an emulated
+// controller (`host::St7735Emulator`) sees the same byte stream as the real hardware.
+
+#pragma once
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Adafruit_GFX.h"
+
+#define ST7735_TFTWIDTH_128 128
+#define ST7735_TFTWIDTH_80 80
+#define ST7735_TFTHEIGHT_128 128
+#define ST7735_TFTHEIGHT_160 160
+
+#define INITR_GREENTAB 0x00
+#define INITR_REDTAB 0x01
+#define INITR_BLACKTAB 0x02
+#define INITR_18GREENTAB INITR_GREENTAB
+#define INITR_18REDTAB INITR_REDTAB
+#define INITR_18BLACKTAB INITR_BLACKTAB
+#define INITR_144GREENTAB 0x01
+#define INITR_MINI160x80 0x04
+#define INITR_HALLOWING 0x05
+
+#define ST77XX_NOP 0x00
+#define ST77XX_SWRESET 0x01
+#define ST77XX_SLPIN 0x10
+#define ST77XX_SLPOUT 0x11
+#define ST77XX_NORON 0x13
+#define ST77XX_INVOFF 0x20
+#define ST77XX_INVON 0x21
+#define ST77XX_DISPOFF 0x28
+#define ST77XX_DISPON 0x29
+#define ST77XX_CASET 0x2A
+#define ST77XX_RASET 0x2B
+#define ST77XX_RAMWR 0x2C
+#define ST77XX_MADCTL 0x36
+#define ST77XX_COLMOD 0x3A
+
+#define ST77XX_MADCTL_MY 0x80
+#define ST77XX_MADCTL_MX 0x40
+#define ST77XX_MADCTL_MV 0x20
+#define ST77XX_MADCTL_ML 0x10
+#define ST77XX_MADCTL_RGB 0x00
+#define ST7735_MADCTL_BGR 0x08
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+#define ST7735_BLACK ST77XX_BLACK
+#define ST7735_WHITE ST77XX_WHITE
+#define ST7735_RED ST77XX_RED
+#define ST7735_GREEN ST77XX_GREEN
+#define ST7735_BLUE ST77XX_BLUE
+#define ST7735_CYAN ST77XX_CYAN
+#define ST7735_MAGENTA ST77XX_MAGENTA
+#define ST7735_YELLOW ST77XX_YELLOW
+#define ST7735_ORANGE ST77XX_ORANGE
+
+/// Reduced SPI TFT base class (hardware SPI only)
+class Adafruit_SPITFT : public Adafruit_GFX {
+  public:
+    Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst)
+        : Adafruit_GFX(w, h), _cs(cs), _dc(dc), _rst(rst) {
+    }
+
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+
+    void startWrite(void) {
+        SPI.beginTransaction(SPISettings());
+        if (_cs >= 0) {
+            digitalWrite(_cs, LOW);
+        }
+    }
+
+    void endWrite(void) {
+        if (_cs >= 0) {
+            digitalWrite(_cs, HIGH);
+        }
+        SPI.endTransaction();
+    }
+
+    void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = NULL,
+                     uint8_t numDataBytes = 0) {
+        startWrite();
+        writeCommand(commandByte);
+        for (uint8_t i = 0; i < numDataBytes; i++) {
+            spiWrite(dataBytes[i]);
+        }
+        endWrite();
+    }
+
+    void writeCommand(uint8_t cmd) {
+        digitalWrite(_dc, LOW);
+        spiWrite(cmd);
+        digitalWrite(_dc, HIGH);
+    }
+
+    void spiWrite(uint8_t b) {
+        SPI.transfer(b);
+    }
+
+    void SPI_WRITE16(uint16_t w) {
+        SPI.transfer(w >> 8);
+        SPI.transfer(w);
+    }
+
+    void SPI_WRITE32(uint32_t l) {
+        SPI.transfer(l >> 24);
+        SPI.transfer(l >> 16);
+        SPI.transfer(l >> 8);
+        SPI.transfer(l);
+    }
+
+    void writePixels(uint16_t *colors, uint32_t len, bool block = true, bool bigEndian = false) {
+        while (len--) {
+            SPI_WRITE16(*colors++);
+        }
+    }
+
+    void writeColor(uint16_t color, uint32_t len) {
+        while (len--) {
+            SPI_WRITE16(color);
+        }
+    }
+
+    void writePixel(int16_t x, int16_t y, uint16_t color) {
+        if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+            setAddrWindow(x, y, 1, 1);
+            SPI_WRITE16(color);
+        }
+    }
+
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (w < 0) {
+            x += w + 1;
+            w = -w;
+        }
+        if (h < 0) {
+            y += h + 1;
+            h = -h;
+        }
+        if (x < 0) {
+            w += x;
+            x = 0;
+        }
+        if (y < 0) {
+            h += y;
+            y = 0;
+        }
+        if (x + w > _width) {
+            w = _width - x;
+        }
+        if (y + h > _height) {
+            h = _height - y;
+        }
+        if (w > 0 && h > 0) {
+            setAddrWindow(x, y, w, h);
+            writeColor(color, (uint32_t)w * h);
+        }
+    }
+
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        writeFillRect(x, y, w, 1, color);
+    }
+
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        writeFillRect(x, y, 1, h, color);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+            startWrite();
+            setAddrWindow(x, y, 1, 1);
+            SPI_WRITE16(color);
+            endWrite();
+        }
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        startWrite();
+        writeFillRect(x, y, w, h, color);
+        endWrite();
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+    void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w, int16_t h) {
+        int16_t x2, y2;
+        if ((x >= _width) || (y >= _height) || ((x2 = (x + w - 1)) < 0) ||
+            ((y2 = (y + h - 1)) < 0)) {
+            return;
+        }
+        int16_t bx1 = 0, by1 = 0, saveW = w;
+        if (x < 0) {
+            w += x;
+            bx1 = -x;
+            x = 0;
+        }
+        if (y < 0) {
+            h += y;
+            by1 = -y;
+            y = 0;
+        }
+        if (x2 >= _width) {
+            w = _width - x;
+        }
+        if (y2 >= _height) {
+            h = _height - y;
+        }
+        pcolors += by1 * saveW + bx1;
+        startWrite();
+        setAddrWindow(x, y, w, h);
+        while (h--) {
+            writePixels(pcolors, w);
+            pcolors += saveW;
+        }
+        endWrite();
+    }
+
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+
+  protected:
+    int8_t _cs;
+    int8_t _dc;
+    int8_t _rst;
+};
+
+/// Reduced ST77xx base class
+class Adafruit_ST77xx : public Adafruit_SPITFT {
+  public:
+    Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst)
+        : Adafruit_SPITFT(w, h, cs, dc, rst), _colstart(0), _rowstart(0), _xstart(0), _ystart(0) {
+    }
+
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+        x += _xstart;
+        y += _ystart;
+        uint32_t xa = ((uint32_t)x << 16) | (x + w - 1);
+        uint32_t ya = ((uint32_t)y << 16) | (y + h - 1);
+        writeCommand(ST77XX_CASET);
+        SPI_WRITE32(xa);
+        writeCommand(ST77XX_RASET);
+        SPI_WRITE32(ya);
+        writeCommand(ST77XX_RAMWR);
+    }
+
+    void enableDisplay(bool enable) {
+        sendCommand(enable ? ST77XX_DISPON : ST77XX_DISPOFF);
+    }
+
+    void invertDisplay(bool i) {
+        sendCommand(i ? ST77XX_INVON : ST77XX_INVOFF);
+    }
+
+  protected:
+    void commonInit() {
+        pinMode(_dc, OUTPUT);
+        digitalWrite(_dc, HIGH);
+        if (_cs >= 0) {
+            pinMode(_cs, OUTPUT);
+            digitalWrite(_cs, HIGH);
+        }
+        SPI.begin();
+    }
+
+    uint8_t _colstart;
+    uint8_t _rowstart;
+    uint8_t _xstart;
+    uint8_t _ystart;
+};
+
+/// Reduced ST7735 driver class
+class Adafruit_ST7735 : public Adafruit_ST77xx {
+  public:
+    Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst)
+        : Adafruit_ST77xx(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160, cs, dc, rst), tabcolor(0) {
+    }
+
+    void initR(uint8_t options = INITR_GREENTAB) {
+        static const uint8_t colmod = 0x05;  // 16 bit color
+        commonInit();
+        sendCommand(ST77XX_SWRESET);
+        sendCommand(ST77XX_SLPOUT);
+        sendCommand(ST77XX_COLMOD, &colmod, 1);
+        switch (options) {
+        case INITR_GREENTAB:
+            _colstart = 2;
+            _rowstart = 1;
+            break;
+        case INITR_144GREENTAB:
+        case INITR_HALLOWING:
+            _colstart = 2;
+            _rowstart = 3;
+            break;
+        case INITR_MINI160x80:
+            _colstart = 24;
+            _rowstart = 0;
+            break;
+        default:
+            _colstart = 0;
+            _rowstart = 0;
+            break;
+        }
+        tabcolor = options;
+        sendCommand(ST77XX_NORON);
+        sendCommand(ST77XX_DISPON);
+        setRotation(0);
+    }
+
+    void setRotation(uint8_t m) {
+        uint8_t madctl = 0;
+        uint8_t order = (tabcolor == INITR_BLACKTAB || tabcolor == INITR_MINI160x80)
+                            ? ST77XX_MADCTL_RGB
+                            : ST7735_MADCTL_BGR;
+        uint8_t shortSide = tabcolor == INITR_MINI160x80 ? ST7735_TFTWIDTH_80 : ST7735_TFTWIDTH_128;
+        uint8_t longSide = (tabcolor == INITR_144GREENTAB || tabcolor == INITR_HALLOWING)
+                               ? ST7735_TFTHEIGHT_128
+                               : ST7735_TFTHEIGHT_160;
+        rotation = m & 3;
+        switch (rotation) {
+        case 0:
+            madctl = ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | order;
+            break;
+        case 1:
+            madctl = ST77XX_MADCTL_MY | ST77XX_MADCTL_MV | order;
+            break;
+        case 2:
+            madctl = order;
+            break;
+        case 3:
+            madctl = ST77XX_MADCTL_MX | ST77XX_MADCTL_MV | order;
+            break;
+        }
+        if (rotation & 1) {
+            _width = longSide;
+            _height = shortSide;
+            _xstart = _rowstart;
+            _ystart = _colstart;
+        } else {
+            _width = shortSide;
+            _height = longSide;
+            _xstart = _colstart;
+            _ystart = _rowstart;
+        }
+        sendCommand(ST77XX_MADCTL, &madctl, 1);
+    }
+
+  protected:
+    uint8_t tabcolor;
+};
@@ -0,0 +1,360 @@
+// Arduino.h - minimal host (Linux/macOS) replacement of the Arduino core
+//
+// This header provides just enough of the Arduino core API in order to compile the hardware
+// driver classes of mupplet-display on a development host. GPIO writes and SPI transfers are
+// routed to instances of `host::Device` (e.g. the MAX7219 chain emulator) so that the bus
+// traffic generated by a driver can be inspected and measured.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "binary.h"
+
+// platform defines
+#define PROGMEM
+#define PGM_P const char *
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_word_near(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_pointer(addr) ((void *)*(void *const *)(addr))
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef uint8_t byte;
+
+template <typename T, typename U>
+static inline auto min(T a, U b) -> typename std::decay<decltype(a < b ? a : b)>::type {
+    return a < b ? a : b;
+}
+
+template <typename T, typename U>
+static inline auto max(T a, U b) -> typename std::decay<decltype(a > b ? a : b)>::type {
+    return a > b ? a : b;
+}
+
+namespace host {
+
+/*! \brief Base class for emulated peripherals
+ *
+ * Every instance registers itself and receives all GPIO writes and SPI transfers issued by the
+ * code under test.
+ */
+class Device {
+  public:
+    Device() {
+        registry().push_back(this);
+    }
+
+    virtual ~Device() {
+        std::vector<Device *> &devices = registry();
+        for (size_t i = 0; i < devices.size(); i++) {
+            if (devices[i] == this) {
+                devices.erase(devices.begin() + i);
+                break;
+            }
+        }
+    }
+
+    virtual void onPinMode(uint8_t pin, uint8_t mode) {
+    }
+
+    virtual void onPinWrite(uint8_t pin, uint8_t value) {
+    }
+
+    virtual void onSpiTransfer(uint8_t data) {
+    }
+
+    static std::vector<Device *> &registry() {
+        static std::vector<Device *> devices;
+        return devices;
+    }
+};
+
+static inline unsigned long elapsedMicros() {
+    static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace host
+
+static inline void pinMode(uint8_t pin, uint8_t mode) {
+    for (host::Device *device : host::Device::registry()) {
+        device->onPinMode(pin, mode);
+    }
+}
+
+static inline void digitalWrite(uint8_t pin, uint8_t value) {
+    for (host::Device *device : host::Device::registry()) {
+        device->onPinWrite(pin, value);
+    }
+}
+
+static inline void analogWrite(uint8_t pin, int value) {
+}
+
+static inline unsigned long micros() {
+    return host::elapsedMicros();
+}
+
+static inline unsigned long millis() {
+    return host::elapsedMicros() / 1000;
+}
+
+static inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static inline void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+/*! \brief Host implementation of the Arduino String class
+ *
+ * Only the subset used by mupplet-display is implemented.
+ */
+class String {
+  protected:
+    std::string str;
+
+  public:
+    String() {
+    }
+    String(const char *s) : str(s ? s : "") {
+    }
+    String(const std::string &s) : str(s) {
+    }
+    explicit String(char c) : str(1, c) {
+    }
+    String(int value, unsigned char base = DEC) {
+        fromLong(value, base);
+    }
+    String(unsigned int value, unsigned char base = DEC) {
+        fromULong(value, base);
+    }
+    String(long value, unsigned char base = DEC) {
+        fromLong(value, base);
+    }
+    String(unsigned long value, unsigned char base = DEC) {
+        fromULong(value, base);
+    }
+    String(double value, unsigned char decimalPlaces = 2) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+        str = buffer;
+    }
+
+    const char *c_str() const {
+        return str.c_str();
+    }
+    unsigned int length() const {
+        return (unsigned int)str.length();
+    }
+    char operator[](unsigned int index) const {
+        return index < str.length() ? str[index] : 0;
+    }
+    char &operator[](unsigned int index) {
+        return str[index];
+    }
+    bool operator==(const String &rhs) const {
+        return str == rhs.str;
+    }
+    bool operator==(const char *rhs) const {
+        return str == rhs;
+    }
+    bool operator!=(const String &rhs) const {
+        return str != rhs.str;
+    }
+    bool operator!=(const char *rhs) const {
+        return str != rhs;
+    }
+    String &operator+=(const String &rhs) {
+        str += rhs.str;
+        return *this;
+    }
+    String &operator+=(const char *rhs) {
+        str += rhs;
+        return *this;
+    }
+    String &operator+=(char rhs) {
+        str += rhs;
+        return *this;
+    }
+    friend String operator+(const String &lhs, const String &rhs) {
+        return String(lhs.str + rhs.str);
+    }
+    friend String operator+(const String &lhs, const char *rhs) {
+        return String(lhs.str + rhs);
+    }
+    friend String operator+(const char *lhs, const String &rhs) {
+        return String(lhs + rhs.str);
+    }
+    bool concat(const String &s) {
+        str += s.str;
+        return true;
+    }
+    bool concat(const char *s) {
+        str += s;
+        return true;
+    }
+    bool concat(long value) {
+        str += String(value).str;
+        return true;
+    }
+    bool concat(unsigned long value) {
+        str += String(value).str;
+        return true;
+    }
+    bool concat(int value) {
+        str += String(value).str;
+        return true;
+    }
+    bool concat(unsigned int value) {
+        str += String(value).str;
+        return true;
+    }
+    bool startsWith(const String &prefix) const {
+        return str.compare(0, prefix.str.length(), prefix.str) == 0;
+    }
+    bool endsWith(const String &suffix) const {
+        return str.length() >= suffix.str.length() &&
+               str.compare(str.length() - suffix.str.length(), suffix.str.length(), suffix.str) ==
+                   0;
+    }
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t pos = str.find(c, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int indexOf(const String &s, unsigned int from = 0) const {
+        size_t pos = str.find(s.str, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int from) const {
+        return from < str.length() ? String(str.substr(from)) : String();
+    }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            unsigned int tmp = from;
+            from = to;
+            to = tmp;
+        }
+        if (from >= str.length()) {
+            return String();
+        }
+        return String(str.substr(from, to - from));
+    }
+    void remove(unsigned int index) {
+        if (index < str.length()) {
+            str.erase(index);
+        }
+    }
+    void remove(unsigned int index, unsigned int count) {
+        if (index < str.length()) {
+            str.erase(index, count);
+        }
+    }
+    void trim() {
+        size_t first = str.find_first_not_of(" \t\r\n");
+        size_t last = str.find_last_not_of(" \t\r\n");
+        str = first == std::string::npos ? std::string() : str.substr(first, last - first + 1);
+    }
+    long toInt() const {
+        return atol(str.c_str());
+    }
+    double toFloat() const {
+        return atof(str.c_str());
+    }
+
+  private:
+    void fromLong(long value, unsigned char base) {
+        if (base == DEC) {
+            str = std::to_string(value);
+        } else {
+            fromULong((unsigned long)value, base);
+        }
+    }
+    void fromULong(unsigned long value, unsigned char base) {
+        char buffer[72];
+        char *pPtr = buffer + sizeof(buffer) - 1;
+        *pPtr = 0;
+        do {
+            unsigned digit = value % base;
+            *--pPtr = digit < 10 ? '0' + digit : 'a' + digit - 10;
+            value /= base;
+        } while (value);
+        str = pPtr;
+    }
+};
+
+/*! \brief Host implementation of the Arduino Print class
+ */
+class Print {
+  public:
+    virtual ~Print() {
+    }
+
+    virtual size_t write(uint8_t) = 0;
+
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+
+    size_t write(const char *str) {
+        return str ? write((const uint8_t *)str, strlen(str)) : 0;
+    }
+
+    size_t print(const String &s) {
+        return write((const uint8_t *)s.c_str(), s.length());
+    }
+    size_t print(const char *s) {
+        return write(s);
+    }
+    size_t print(char c) {
+        return write((uint8_t)c);
+    }
+    size_t print(int value, int base = DEC) {
+        return print(String(value, (unsigned char)base));
+    }
+    size_t print(long value, int base = DEC) {
+        return print(String(value, (unsigned char)base));
+    }
+    size_t print(unsigned long value, int base = DEC) {
+        return print(String(value, (unsigned char)base));
+    }
+    size_t print(double value, int digits = 2) {
+        return print(String(value, (unsigned char)digits));
+    }
+    size_t println() {
+        return write("\r\n");
+    }
+    template <typename T> size_t println(T value) {
+        size_t n = print(value);
+        return n + println();
+    }
+};
@@ -0,0 +1,56 @@
+// SPI.h - minimal host replacement of the Arduino SPI library
+//
+// All transferred bytes are forwarded to the registered `host::Device` instances. Received data
+// is always read back as zero.
+
+#pragma once
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+
+class SPISettings {
+  public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = 1, uint8_t dataMode = SPI_MODE0)
+        : clock(clock) {
+    }
+    uint32_t clock;
+};
+
+class SPIClass {
+  public:
+    void begin() {
+    }
+
+    void end() {
+    }
+
+    void beginTransaction(SPISettings settings) {
+    }
+
+    void endTransaction() {
+    }
+
+    uint8_t transfer(uint8_t data) {
+        for (host::Device *device : host::Device::registry()) {
+            device->onSpiTransfer(data);
+        }
+        return 0;
+    }
+
+    void transfer(void *buffer, size_t size) {
+        uint8_t *pPtr = (uint8_t *)buffer;
+        while (size--) {
+            *pPtr = transfer(*pPtr);
+            pPtr++;
+        }
+    }
+
+    void writeBytes(const uint8_t *data, uint32_t size) {
+        while (size--) {
+            transfer(*data++);
+        }
+    }
+};
+
+static SPIClass SPI;
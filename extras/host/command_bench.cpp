@@ -0,0 +1,378 @@
+// command_bench.cpp - host benchmark and regression check of the display command dispatcher
+//
+// Build and run on a development host:
+//
+//     g++ -std=c++11 -O2 -Wall -I extras/host -I src extras/host/command_bench.cpp -o command_bench
+//     ./command_bench [--rounds <n>]
+//
+// The benchmark feeds the message topics of the display mupplets into `MuppletDisplay` and checks
+// the replies. The throughput of the dispatch table is compared with the chain of `startsWith()`,
+// `substring()` and string comparisons that was used before. The program exits with a non-zero
+// exit code if a command is not resolved or answered as expected.
+
+#define USTD_FEATURE_PROGRAMPLAYER
+
+#include "Arduino.h"
+#include "helper/mup_display.h"
+
+using ustd::MuppletDisplay;
+using ustd::Scheduler;
+
+// benchmark parameters
+static unsigned long rounds = 20000;
+static int failures = 0;
+
+// display mupplet without display hardware
+class BenchDisplay : public MuppletDisplay {
+  protected:
+    int16_t cursorX, cursorY;
+    bool wrap;
+
+  public:
+    using MuppletDisplay::CommandEntry;
+    using MuppletDisplay::commandParser;
+    using MuppletDisplay::commandTable;
+    using MuppletDisplay::commandTableSize;
+    using MuppletDisplay::findCommand;
+
+    BenchDisplay(String name) : MuppletDisplay(name, MUPDISP_FEATURE_COLOR) {
+        cursorX = cursorY = 0;
+        wrap = false;
+    }
+
+    void begin(Scheduler *_pSched) {
+        pSched = _pSched;
+        tID = pSched->add([this]() {}, name, 10000L);
+        pSched->subscribe(tID, name + "/display/#", [this](String topic, String msg, String org) {
+            if (topic.length() > name.length() + 8) {
+                this->commandParser(topic.c_str() + name.length() + 9, msg);
+            }
+        });
+        programInit();
+    }
+
+    unsigned int getItemCount() {
+        return program.length();
+    }
+
+  protected:
+    virtual void getDimensions(int16_t &width, int16_t &height) {
+        width = 160;
+        height = 128;
+    }
+    virtual bool getTextWrap() {
+        return wrap;
+    }
+    virtual void setTextWrap(bool wrap) {
+        this->wrap = wrap;
+    }
+    virtual FontSize getTextFontSize() {
+        FontSize fs = {7, 6, 8, 0};
+        return fs;
+    }
+    virtual uint8_t getTextFontCount() {
+        return 1;
+    }
+    virtual void setTextFont(uint8_t font, int16_t baseLineAdjustment) {
+    }
+    virtual void setTextColor(uint16_t fg, uint16_t bg) {
+    }
+    virtual void getCursor(int16_t &x, int16_t &y) {
+        x = cursorX;
+        y = cursorY;
+    }
+    virtual void setCursor(int16_t x, int16_t y) {
+        cursorX = x;
+        cursorY = y;
+    }
+    virtual void displayClear(int16_t x, int16_t y, int16_t w, int16_t h) {
+    }
+    virtual void displayClear(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t bg) {
+    }
+    virtual void displayPrint(String content, bool ln = false) {
+    }
+    virtual bool displayFormat(int16_t x, int16_t y, int16_t w, int16_t align, String content,
+                               uint8_t font, uint16_t color, uint16_t bg) {
+        return true;
+    }
+    virtual bool initNextCharDimensions(ProgramItem &item) {
+        return false;
+    }
+};
+
+// reference: the dispatch chain used before the dispatch table, including the substring of the
+// subscription callback. Returns the resolved command or -1.
+static int16_t legacyResolve(const String &topic, unsigned int prefixLength) {
+    String command = topic.substring(prefixLength);
+    if (command.startsWith("cmnd/")) {
+        String sub = command.substring(5);
+        if (sub == "clear") {
+            return BenchDisplay::CmdClear;
+        } else if (sub == "print") {
+            return BenchDisplay::CmdPrint;
+        } else if (sub == "println") {
+            return BenchDisplay::CmdPrintln;
+        } else if (sub == "printat") {
+            return BenchDisplay::CmdPrintAt;
+        } else if (sub == "format") {
+            return BenchDisplay::CmdFormat;
+        }
+    } else if (command.startsWith("cursor/")) {
+        String sub = command.substring(7);
+        const char *paths[] = {"get", "set", "x/get", "x/set", "y/get", "y/set", nullptr};
+        for (int16_t i = 0; paths[i]; i++) {
+            if (sub == paths[i]) {
+                return BenchDisplay::CursorGet + i;
+            }
+        }
+    } else if (command.startsWith("wrap/")) {
+        String sub = command.substring(5);
+        if (sub == "get") {
+            return BenchDisplay::WrapGet;
+        } else if (sub == "set") {
+            return BenchDisplay::WrapSet;
+        }
+    } else if (command.startsWith("color/")) {
+        String sub = command.substring(6);
+        if (sub == "get") {
+            return BenchDisplay::ColorGet;
+        } else if (sub == "set") {
+            return BenchDisplay::ColorSet;
+        }
+    } else if (command.startsWith("background/")) {
+        String sub = command.substring(11);
+        if (sub == "get") {
+            return BenchDisplay::BackgroundGet;
+        } else if (sub == "set") {
+            return BenchDisplay::BackgroundSet;
+        }
+    } else if (command == "count/get") {
+        return BenchDisplay::CountGet;
+    } else if (command.startsWith("default/")) {
+        String sub = command.substring(8);
+        const char *paths[] = {"get",          "set",          "mode/get",       "mode/set",
+                               "repeat/get",   "repeat/set",   "duration/get",   "duration/set",
+                               "speed/get",    "speed/set",    "font/get",       "font/set",
+                               "color/get",    "color/set",    "background/get", "background/set",
+                               nullptr};
+        for (int16_t i = 0; paths[i]; i++) {
+            if (sub == paths[i]) {
+                return BenchDisplay::DefaultGet + i;
+            }
+        }
+    } else if (command.startsWith("items/")) {
+        String sub = command.substring(6);
+        if (sub == "clear") {
+            return BenchDisplay::ItemsClear;
+        } else if (sub == "get") {
+            return BenchDisplay::ItemsGet;
+        } else if (sub == "add") {
+            return BenchDisplay::ItemsAdd;
+        }
+    } else if (command.startsWith("content/")) {
+        String sub = command.substring(8);
+        if (sub == "clear") {
+            return BenchDisplay::ContentClear;
+        } else if (sub == "get") {
+            return BenchDisplay::ContentGet;
+        } else if (sub == "add") {
+            return BenchDisplay::ContentAdd;
+        }
+    }
+    return -1;
+}
+
+static void checkTable() {
+    const BenchDisplay::CommandEntry *table = BenchDisplay::commandTable;
+    uint8_t count = BenchDisplay::commandTableSize;
+    bool seen[BenchDisplay::CommandCount] = {false};
+    if (count != BenchDisplay::CommandCount) {
+        printf("FAIL: dispatch table has %d entries for %d commands\n", count,
+               BenchDisplay::CommandCount);
+        failures++;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (i && strcmp(table[i - 1].path, table[i].path) >= 0) {
+            printf("FAIL: dispatch table not sorted at %s\n", table[i].path);
+            failures++;
+        }
+        if (table[i].command >= BenchDisplay::CommandCount || seen[table[i].command]) {
+            printf("FAIL: dispatch table entry %s has an invalid command\n", table[i].path);
+            failures++;
+        } else {
+            seen[table[i].command] = true;
+        }
+        if (BenchDisplay::findCommand(table, count, table[i].path) != table[i].command) {
+            printf("FAIL: %s is not found in the dispatch table\n", table[i].path);
+            failures++;
+        }
+        String topic = String("bench/display/") + table[i].path;
+        if (legacyResolve(topic, 14) != table[i].command) {
+            printf("FAIL: %s resolves to a different command than before\n", table[i].path);
+            failures++;
+        }
+    }
+    const char *unknown[] = {"",          "cmnd",  "cmnd/", "cmnd/printx", "cursor/z/get",
+                             "wrap/get/", "a/get", "zzz",   "items/foo",   "default/",
+                             nullptr};
+    for (int i = 0; unknown[i]; i++) {
+        if (BenchDisplay::findCommand(table, count, unknown[i]) >= 0) {
+            printf("FAIL: unknown command '%s' found in the dispatch table\n", unknown[i]);
+            failures++;
+        }
+    }
+}
+
+static void checkReply(Scheduler &sched, const char *command, const char *args, const char *topic,
+                       const char *msg) {
+    // the scheduler records the command itself when it is not answered
+    unsigned long published = sched.publishCount;
+    sched.publish(String("bench/display/") + command, args);
+    bool answered = sched.publishCount - published > 1;
+    if (!*topic) {
+        if (answered) {
+            printf("FAIL: %s(%s): unexpected reply %s=%s\n", command, args,
+                   sched.lastTopic.c_str(), sched.lastMsg.c_str());
+            failures++;
+        }
+    } else if (!answered || !(sched.lastTopic == topic) || (msg && !(sched.lastMsg == msg))) {
+        printf("FAIL: %s(%s): expected %s=%s, got %s=%s\n", command, args, topic, msg ? msg : "*",
+               sched.lastTopic.c_str(), sched.lastMsg.c_str());
+        failures++;
+    }
+}
+
+static void checkCommands(Scheduler &sched, BenchDisplay &display) {
+    checkReply(sched, "cursor/set", "12;34", "bench/display/cursor", "12;34");
+    checkReply(sched, "cursor/x/set", "20", "bench/display/cursor/x", "20");
+    checkReply(sched, "cursor/y/get", "", "bench/display/cursor/y", "34");
+    checkReply(sched, "cursor/get", "", "bench/display/cursor", "20;34");
+    checkReply(sched, "wrap/set", "on", "bench/display/wrap", "on");
+    checkReply(sched, "wrap/get", "", "bench/display/wrap", "on");
+    checkReply(sched, "color/set", "red", "bench/display/color", "0xf800");
+    checkReply(sched, "background/set", "0x001f", "bench/display/background", "0x1f");
+    checkReply(sched, "background/get", "", "bench/display/background", "0x1f");
+    checkReply(sched, "default/mode/set", "marquee", "bench/display/default/mode", "marquee");
+    checkReply(sched, "default/speed/set", "8", "bench/display/default/speed", "8");
+    checkReply(sched, "default/duration/get", "", "bench/display/default/duration", "2000");
+    checkReply(sched, "items/add", "left;;;;;;;hello", "bench/display/count", "1");
+    checkReply(sched, "items/clock/set", "center;0;1000;16;0;;;12:00",
+               "bench/display/items/clock", "center;0;1000;16;0;0xffff;0x0;12:00");
+    checkReply(sched, "content/clock/set", "12:01", "bench/display/content/clock", "12:01");
+    checkReply(sched, "items/clock/get", "", "bench/display/items/clock",
+               "center;0;1000;16;0;0xffff;0x0;12:01");
+    checkReply(sched, "content/news/set", "breaking", "bench/display/content/news", nullptr);
+    checkReply(sched, "count/get", "", "bench/display/count", "3");
+    checkReply(sched, "items/clock/clear", "", "bench/display/count", "2");
+    checkReply(sched, "items/clear", "", "bench/display/count", "0");
+    if (display.getItemCount() != 0) {
+        printf("FAIL: program not empty after items/clear\n");
+        failures++;
+    }
+    // unknown commands must not be answered
+    checkReply(sched, "cursor/z/get", "", "", nullptr);
+    checkReply(sched, "items/clock", "", "", nullptr);
+    checkReply(sched, "items//get", "", "", nullptr);
+    // the parent topic is delivered to the subscription as well and must be ignored
+    unsigned long published = sched.publishCount;
+    sched.publish("bench/display", "");
+    if (sched.publishCount - published != 1) {
+        printf("FAIL: bench/display: unexpected reply %s=%s\n", sched.lastTopic.c_str(),
+               sched.lastMsg.c_str());
+        failures++;
+    }
+}
+
+static double elapsed(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count();
+}
+
+static void benchDispatch(Scheduler &sched, BenchDisplay &display) {
+    const BenchDisplay::CommandEntry *table = BenchDisplay::commandTable;
+    uint8_t count = BenchDisplay::commandTableSize;
+    std::vector<String> topics;
+    for (uint8_t i = 0; i < count; i++) {
+        topics.push_back(String("bench/display/") + table[i].path);
+    }
+    unsigned long n = rounds * topics.size();
+    volatile long sink = 0;
+
+    printf("Command dispatch, %d commands, %lu rounds\n\n", count, rounds);
+    printf("%-36s %12s %12s\n", "scenario", "commands/s", "ns/command");
+    printf("%-36s %12s %12s\n", "------------------------------------", "------------",
+           "------------");
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < topics.size(); i++) {
+            sink += legacyResolve(topics[i], 14);
+        }
+    }
+    double legacy = elapsed(start);
+    printf("%-36s %12.0f %12.1f\n", "resolve: startsWith/substring chain", n / legacy,
+           legacy * 1e9 / n);
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < topics.size(); i++) {
+            sink += BenchDisplay::findCommand(table, count, topics[i].c_str() + 14);
+        }
+    }
+    double lookup = elapsed(start);
+    printf("%-36s %12.0f %12.1f\n", "resolve: dispatch table", n / lookup, lookup * 1e9 / n);
+
+    // complete commands with argument parsing and reply, delivered by the scheduler
+    const char *commands[][2] = {
+        {"cursor/set", "10;20"},   {"cursor/get", ""},      {"cursor/x/get", ""},
+        {"wrap/set", "off"},       {"color/set", "0xffe0"}, {"background/get", ""},
+        {"default/speed/get", ""}, {"count/get", ""},       {"content/clock/set", "12:00"},
+        {"items/clock/get", ""},
+    };
+    const size_t commandCount = sizeof(commands) / sizeof(commands[0]);
+    std::vector<String> commandTopics;
+    for (size_t i = 0; i < commandCount; i++) {
+        commandTopics.push_back(String("bench/display/") + commands[i][0]);
+    }
+    unsigned long published = sched.publishCount;
+    unsigned long m = rounds * commandCount;
+    start = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < commandCount; i++) {
+            sched.publish(commandTopics[i], commands[i][1]);
+        }
+    }
+    double full = elapsed(start);
+    printf("%-36s %12.0f %12.1f\n", "complete command (publish to reply)", m / full,
+           full * 1e9 / m);
+    if (sched.publishCount - published != 2 * m) {
+        printf("FAIL: %lu of %lu commands answered\n", sched.publishCount - published - m, m);
+        failures++;
+    }
+    printf("\nspeedup of the dispatch table: %.1fx\n\n", legacy / lookup);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (!strcmp(argv[i], "--rounds")) {
+            rounds = atol(argv[++i]);
+        }
+    }
+    if (rounds == 0) {
+        rounds = 1;
+    }
+
+    Scheduler sched;
+    BenchDisplay display("bench");
+    display.begin(&sched);
+
+    checkTable();
+    checkCommands(sched, display);
+    benchDispatch(sched, display);
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// glcdfont.c - synthetic replacement of the Adafruit GFX 'classic' 5x7 font
+//
+// The glyph shapes are generated pseudo randomly and have nothing in common with the original
+// font. They only serve to produce a realistic pixel density for host benchmarks.
+
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+static const unsigned char font[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x6E, 0x61, 0x44, 0x4F,
+    0x63, 0x5B, 0x59, 0x56, 0x73, 0x0E, 0x4E, 0x48, 0x0C, 0x77,
+    0x3C, 0x59, 0x51, 0x77, 0x45, 0x40, 0x36, 0x3B, 0x18, 0x7E,
+    0x5E, 0x6D, 0x22, 0x6F, 0x34, 0x1C, 0x15, 0x12, 0x4B, 0x6C,
+    0x1A, 0x18, 0x76, 0x7D, 0x55, 0x2E, 0x27, 0x1C, 0x1C, 0x0A,
+    0x08, 0x2C, 0x77, 0x37, 0x5B, 0x52, 0x57, 0x21, 0x12, 0x63,
+    0x17, 0x60, 0x2D, 0x0F, 0x33, 0x44, 0x58, 0x4A, 0x4B, 0x25,
+    0x40, 0x7E, 0x56, 0x67, 0x39, 0x72, 0x25, 0x4F, 0x11, 0x78,
+    0x1E, 0x09, 0x31, 0x59, 0x36, 0x75, 0x79, 0x01, 0x2B, 0x35,
+    0x59, 0x6B, 0x07, 0x77, 0x30, 0x4A, 0x55, 0x03, 0x65, 0x7C,
+    0x20, 0x04, 0x46, 0x30, 0x2F, 0x16, 0x23, 0x51, 0x03, 0x13,
+    0x29, 0x39, 0x0D, 0x1D, 0x00, 0x17, 0x2F, 0x6B, 0x24, 0x1C,
+    0x79, 0x55, 0x04, 0x68, 0x20, 0x1D, 0x5C, 0x38, 0x3D, 0x03,
+    0x53, 0x4C, 0x4C, 0x07, 0x54, 0x19, 0x5F, 0x7C, 0x2C, 0x33,
+    0x25, 0x51, 0x68, 0x79, 0x1E, 0x1F, 0x6C, 0x7E, 0x1C, 0x72,
+    0x54, 0x3A, 0x79, 0x57, 0x0B, 0x75, 0x1A, 0x2A, 0x2C, 0x6F,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 0x1C, 0x1B, 0x50, 0x06,
+    0x06, 0x62, 0x52, 0x1D, 0x71, 0x4D, 0x30, 0x44, 0x61, 0x46,
+    0x4E, 0x0C, 0x66, 0x6E, 0x25, 0x33, 0x60, 0x7F, 0x74, 0x62,
+    0x15, 0x64, 0x28, 0x2C, 0x74, 0x15, 0x08, 0x47, 0x26, 0x34,
+    0x20, 0x08, 0x5A, 0x69, 0x73, 0x20, 0x4D, 0x7E, 0x60, 0x19,
+    0x1C, 0x39, 0x50, 0x0E, 0x49, 0x7D, 0x25, 0x2D, 0x0F, 0x1F,
+    0x62, 0x6E, 0x66, 0x09, 0x1A, 0x10, 0x54, 0x11, 0x1A, 0x58,
+    0x7A, 0x17, 0x56, 0x09, 0x5A, 0x61, 0x14, 0x22, 0x69, 0x36,
+    0x5A, 0x5A, 0x58, 0x3C, 0x18, 0x5C, 0x22, 0x12, 0x16, 0x42,
+    0x56, 0x2C, 0x1C, 0x53, 0x22, 0x72, 0x63, 0x7D, 0x23, 0x18,
+    0x3E, 0x11, 0x6E, 0x3B, 0x08, 0x41, 0x5E, 0x41, 0x4C, 0x59,
+    0x1C, 0x6D, 0x37, 0x40, 0x6F, 0x44, 0x3E, 0x2E, 0x49, 0x23,
+    0x0F, 0x2A, 0x0D, 0x1D, 0x39, 0x4B, 0x21, 0x16, 0x1A, 0x2B,
+    0x38, 0x21, 0x0C, 0x29, 0x5C, 0x19, 0x4F, 0x67, 0x3E, 0x01,
+    0x34, 0x7F, 0x3E, 0x1C, 0x0F, 0x03, 0x38, 0x4C, 0x5A, 0x3B,
+    0x14, 0x2B, 0x29, 0x1E, 0x0C, 0x6B, 0x52, 0x0C, 0x3C, 0x6E,
+    0x58, 0x51, 0x6B, 0x24, 0x1C, 0x5A, 0x1B, 0x28, 0x42, 0x35,
+    0x52, 0x1A, 0x64, 0x4A, 0x27, 0x3A, 0x79, 0x5B, 0x0B, 0x49,
+    0x03, 0x3D, 0x5D, 0x20, 0x7C, 0x54, 0x2C, 0x0D, 0x7E, 0x4F,
+    0x49, 0x70, 0x35, 0x29, 0x14, 0x1A, 0x05, 0x5B, 0x04, 0x61,
+    0x7A, 0x61, 0x73, 0x03, 0x73, 0x73, 0x2F, 0x40, 0x0E, 0x00,
+    0x41, 0x35, 0x52, 0x6A, 0x7B, 0x7A, 0x1F, 0x05, 0x43, 0x7B,
+    0x56, 0x4D, 0x22, 0x17, 0x48, 0x69, 0x0C, 0x7A, 0x60, 0x63,
+    0x6D, 0x3B, 0x0F, 0x25, 0x78, 0x34, 0x7A, 0x33, 0x2E, 0x25,
+    0x66, 0x2A, 0x30, 0x08, 0x5F, 0x7C, 0x46, 0x32, 0x2C, 0x68,
+    0x2B, 0x2E, 0x72, 0x3C, 0x1E, 0x59, 0x2A, 0x4A, 0x29, 0x3D,
+    0x44, 0x2C, 0x30, 0x2E, 0x18, 0x37, 0x39, 0x26, 0x11, 0x40,
+    0x7D, 0x61, 0x18, 0x11, 0x32, 0x38, 0x42, 0x29, 0x16, 0x3F,
+    0x38, 0x37, 0x3B, 0x1D, 0x6A, 0x55, 0x16, 0x2E, 0x73, 0x05,
+    0x45, 0x5A, 0x4A, 0x6C, 0x23, 0x33, 0x2E, 0x50, 0x0E, 0x51,
+    0x50, 0x53, 0x73, 0x6D, 0x3D, 0x6D, 0x1E, 0x40, 0x12, 0x2B,
+    0x43, 0x19, 0x5E, 0x29, 0x4B, 0x41, 0x55, 0x50, 0x60, 0x0F,
+    0x3A, 0x50, 0x37, 0x49, 0x0A, 0x5C, 0x20, 0x41, 0x69, 0x28,
+    0x4F, 0x2C, 0x4E, 0x24, 0x68, 0x41, 0x6D, 0x75, 0x4C, 0x16,
+    0x68, 0x38, 0x26, 0x39, 0x34, 0x76, 0x34, 0x11, 0x4C, 0x65,
+    0x56, 0x73, 0x19, 0x64, 0x58, 0x03, 0x1C, 0x34, 0x7F, 0x51,
+    0x61, 0x78, 0x55, 0x2F, 0x24, 0x6B, 0x34, 0x54, 0x40, 0x63,
+    0x14, 0x32, 0x5B, 0x09, 0x16, 0x17, 0x53, 0x55, 0x4C, 0x05,
+    0x67, 0x4C, 0x4E, 0x52, 0x25, 0x79, 0x7E, 0x00, 0x17, 0x2D,
+    0x16, 0x5A, 0x2D, 0x76, 0x76, 0x53, 0x69, 0x60, 0x30, 0x1E,
+    0x4D, 0x6E, 0x4F, 0x0C, 0x04, 0x56, 0x6B, 0x2A, 0x52, 0x00,
+    0x6D, 0x16, 0x3D, 0x3D, 0x22, 0x25, 0x79, 0x47, 0x02, 0x37,
+    0x14, 0x7D, 0x3E, 0x55, 0x66, 0x5B, 0x0C, 0x0F, 0x36, 0x3B,
+    0x32, 0x17, 0x2D, 0x4D, 0x54, 0x1D, 0x7B, 0x57, 0x7D, 0x6A,
+    0x4B, 0x2D, 0x6E, 0x3C, 0x67, 0x70, 0x2A, 0x64, 0x2B, 0x06,
+    0x3D, 0x20, 0x2B, 0x5D, 0x50, 0x39, 0x24, 0x5F, 0x6E, 0x5C,
+    0x23, 0x33, 0x14, 0x39, 0x77, 0x3A, 0x7A, 0x5D, 0x58, 0x44,
+    0x24, 0x50, 0x54, 0x16, 0x27, 0x6E, 0x7D, 0x1C, 0x3C, 0x05,
+    0x54, 0x6E, 0x06, 0x34, 0x74, 0x05, 0x23, 0x7E, 0x7E, 0x3A,
+    0x74, 0x31, 0x48, 0x02, 0x2D, 0x79, 0x44, 0x6B, 0x1C, 0x43,
+    0x32, 0x55, 0x39, 0x53, 0x05, 0x71, 0x71, 0x24, 0x16, 0x7B,
+    0x32, 0x03, 0x0B, 0x37, 0x35, 0x6A, 0x06, 0x2D, 0x0F, 0x1D,
+    0x0D, 0x24, 0x77, 0x06, 0x3C, 0x5F, 0x55, 0x51, 0x2C, 0x19,
+    0x0F, 0x47, 0x22, 0x42, 0x12, 0x6B, 0x78, 0x78, 0x22, 0x57,
+    0x4B, 0x44, 0x62, 0x54, 0x6A, 0x19, 0x23, 0x3A, 0x79, 0x0D,
+    0x6D, 0x0D, 0x69, 0x54, 0x4E, 0x54, 0x18, 0x01, 0x64, 0x39,
+    0x47, 0x7D, 0x2C, 0x62, 0x3F, 0x43, 0x09, 0x12, 0x43, 0x61,
+    0x14, 0x7E, 0x34, 0x2E, 0x26, 0x70, 0x07, 0x4C, 0x26, 0x1D,
+    0x67, 0x5C, 0x13, 0x47, 0x29, 0x04, 0x50, 0x13, 0x74, 0x22,
+    0x33, 0x28, 0x2C, 0x4D, 0x4C, 0x0B, 0x23, 0x10, 0x75, 0x3D,
+    0x7E, 0x65, 0x1E, 0x11, 0x69, 0x73, 0x55, 0x4F, 0x7A, 0x07,
+    0x18, 0x0B, 0x66, 0x54, 0x5B, 0x42, 0x66, 0x6B, 0x57, 0x39,
+    0x67, 0x78, 0x19, 0x16, 0x74, 0x42, 0x46, 0x3B, 0x64, 0x60,
+    0x2E, 0x66, 0x43, 0x3C, 0x18, 0x0A, 0x01, 0x49, 0x48, 0x6A,
+    0x5D, 0x04, 0x50, 0x7B, 0x0F, 0x2C, 0x1C, 0x77, 0x38, 0x40,
+    0x3B, 0x41, 0x0A, 0x3D, 0x6D, 0x7C, 0x37, 0x14, 0x72, 0x69,
+    0x1A, 0x6D, 0x0D, 0x04, 0x28, 0x1E, 0x5A, 0x5E, 0x15, 0x6A,
+    0x55, 0x39, 0x46, 0x7A, 0x26, 0x65, 0x79, 0x1B, 0x2E, 0x5D,
+    0x36, 0x3D, 0x52, 0x20, 0x75, 0x27, 0x0A, 0x51, 0x0C, 0x7B,
+    0x28, 0x0E, 0x5F, 0x6E, 0x69, 0x10, 0x46, 0x43, 0x3D, 0x07,
+    0x3C, 0x0C, 0x56, 0x33, 0x4D, 0x20, 0x72, 0x42, 0x3E, 0x5B,
+    0x69, 0x6D, 0x79, 0x18, 0x76, 0x51, 0x3F, 0x6F, 0x45, 0x0D,
+    0x0C, 0x2F, 0x40, 0x21, 0x49, 0x1A, 0x19, 0x01, 0x34, 0x63,
+    0x17, 0x7C, 0x0F, 0x68, 0x22, 0x50, 0x0C, 0x2F, 0x0D, 0x09,
+    0x73, 0x22, 0x25, 0x1E, 0x19, 0x0B, 0x7D, 0x49, 0x01, 0x4E,
+    0x77, 0x2A, 0x4F, 0x68, 0x13, 0x1A, 0x71, 0x2B, 0x77, 0x50,
+    0x0B, 0x36, 0x42, 0x36, 0x26, 0x36, 0x11, 0x09, 0x19, 0x60,
+    0x4D, 0x33, 0x33, 0x2A, 0x3B, 0x68, 0x2D, 0x4C, 0x41, 0x02,
+    0x53, 0x7A, 0x79, 0x1D, 0x6C, 0x5E, 0x77, 0x72, 0x6E, 0x57,
+    0x5B, 0x74, 0x63, 0x74, 0x15, 0x2C, 0x19, 0x2F, 0x7B, 0x55,
+    0x0C, 0x69, 0x0C, 0x37, 0x14, 0x29, 0x02, 0x44, 0x4F, 0x14,
+    0x19, 0x74, 0x4C, 0x2C, 0x22, 0x60, 0x7C, 0x49, 0x46, 0x20,
+    0x59, 0x57, 0x1B, 0x66, 0x53, 0x55, 0x68, 0x57, 0x7F, 0x09,
+    0x38, 0x2D, 0x7F, 0x03, 0x21, 0x0D, 0x2F, 0x59, 0x52, 0x29,
+    0x15, 0x1C, 0x5E, 0x16, 0x05, 0x1C, 0x4A, 0x6A, 0x17, 0x60,
+    0x57, 0x1D, 0x4A, 0x64, 0x11, 0x1D, 0x75, 0x10, 0x14, 0x2E,
+    0x71, 0x7D, 0x21, 0x08, 0x08, 0x67, 0x64, 0x2E, 0x1C, 0x70,
+    0x03, 0x10, 0x17, 0x1A, 0x66, 0x60, 0x16, 0x02, 0x49, 0x34,
+    0x54, 0x5D, 0x03, 0x60, 0x58, 0x34, 0x13, 0x11, 0x5F, 0x5F,
+    0x6F, 0x2A, 0x07, 0x43, 0x0D, 0x5E, 0x40, 0x4B, 0x2E, 0x12,
+    0x72, 0x27, 0x6D, 0x70, 0x6E, 0x47, 0x0B, 0x4B, 0x17, 0x16,
+    0x77, 0x36, 0x4D, 0x77, 0x20, 0x62, 0x1C, 0x00, 0x7B, 0x3B,
+    0x29, 0x79, 0x53, 0x42, 0x58, 0x12, 0x54, 0x28, 0x3E, 0x68,
+    0x55, 0x30, 0x4A, 0x36, 0x69, 0x42, 0x32, 0x5B, 0x24, 0x4E,
+    0x1F, 0x10, 0x2D, 0x66, 0x17, 0x65, 0x08, 0x1A, 0x2E, 0x00,
+    0x20, 0x12, 0x6C, 0x15, 0x17, 0x6E, 0x7D, 0x24, 0x4E, 0x5E,
+    0x1B, 0x76, 0x33, 0x00, 0x3C, 0x55, 0x4D, 0x7D, 0x7B, 0x0E,
+    0x09, 0x61, 0x47, 0x27, 0x42, 0x3E, 0x4D, 0x61, 0x12, 0x01,
+    0x26, 0x6C, 0x5B, 0x0F, 0x40, 0x6D, 0x13, 0x27, 0x0E, 0x30,
+    0x53, 0x77, 0x6F, 0x2D, 0x1F, 0x7B, 0x5F, 0x3C, 0x73, 0x19,
+    0x60, 0x18, 0x12, 0x7E, 0x26, 0x15, 0x0E, 0x36, 0x05, 0x21,
+    0x16, 0x0D, 0x1B, 0x7C, 0x02, 0x29, 0x3D, 0x37, 0x20, 0x64,
+    0x22, 0x6E, 0x3C, 0x6B, 0x52, 0x45, 0x71, 0x18, 0x4C, 0x23,
+    0x32, 0x0F, 0x7A, 0x31, 0x18, 0x1A, 0x55, 0x11, 0x69, 0x45,
+    0x58, 0x5E, 0x6C, 0x39, 0x26, 0x68, 0x6F, 0x59, 0x7A, 0x2C,
+    0x14, 0x1E, 0x52, 0x15, 0x60, 0x33, 0x5B, 0x75, 0x02, 0x4F,
+    0x1B, 0x42, 0x63, 0x56, 0x61, 0x11, 0x71, 0x2F, 0x6C, 0x52,
+    0x2B, 0x63, 0x5E, 0x51, 0x6D, 0x7B, 0x5F, 0x68, 0x79, 0x16,
+    0x10, 0x05, 0x49, 0x4C, 0x36, 0x5F, 0x17, 0x46, 0x23, 0x77,
+    0x28, 0x1A, 0x64, 0x51, 0x5C, 0x67, 0x2C, 0x6F, 0x77, 0x34,
+    0x03, 0x12, 0x2D, 0x09, 0x2E, 0x30, 0x6F, 0x4B, 0x5D, 0x34,
+    0x78, 0x58, 0x17, 0x78, 0x16, 0x67, 0x66, 0x02, 0x39, 0x1D
+};
+
+#endif  // FONT5X7_H
@@ -0,0 +1,196 @@
+// ht162x_bench.cpp - host benchmark and regression check of the HT162x digits driver
+//
+// Build and run on a development host:
+//
+//     g++ -std=c++11 -O2 -Wall -I extras/host -I src extras/host/ht162x_bench.cpp -o ht162x_bench
+//     ./ht162x_bench [--bit <us>] [--overhead <us>]
+//
+// The benchmark drives `Ht162xDigits` against the HT162x emulator and reports the bit banging
+// traffic caused by typical display updates compared with a complete transmission of the display
+// RAM. The display RAM of the emulator is compared with a second emulated controller that always
+// receives the complete display RAM. The program exits with a non-zero exit code if they differ.
+
+#include "Arduino.h"
+#include "ht162x_emulator.h"
+#include "hardware/ht162x_digits.h"
+
+using host::Ht162xEmulator;
+using ustd::Ht162xDigits;
+
+// benchmark parameters
+static double bitTime = 8.0;
+static double frameOverhead = 1.0;
+static int failures = 0;
+
+static void report(const char *scenario, const Ht162xEmulator &emu, unsigned long writes) {
+    const Ht162xEmulator::Stats &stats = emu.getStats();
+    double n = writes ? writes : 1;
+    printf("%-28s %9.1f %8.2f %8.1f %10.1f\n", scenario, stats.bits / n, stats.frames / n,
+           stats.nibbles / n, emu.getBusTime(bitTime, frameOverhead) / n);
+}
+
+static void verify(const char *scenario, const Ht162xEmulator &emu, const Ht162xEmulator &ref) {
+    for (uint8_t address = 0; address < 64; address++) {
+        if (emu.getNibble(address) != ref.getNibble(address)) {
+            printf("FAIL: %s: display RAM nibble %d differs\n", scenario, address);
+            failures++;
+            return;
+        }
+    }
+}
+
+static void benchType(Ht162xDigits::LcdType lcdType, const char *name) {
+    Ht162xEmulator emu(10, 11, 12), refEmu(20, 21, 22);
+    Ht162xDigits digits(lcdType, 10, 11, 12), ref(lcdType, 20, 21, 22);
+    int16_t width = digits.width();
+
+    printf("%s (%d digits), %.1f us per bit, %.1f us per frame\n\n", name, width, bitTime,
+           frameOverhead);
+    printf("%-28s %9s %8s %8s %10s\n", "scenario (per write)", "bits", "frames", "nibbles",
+           "bus us");
+    printf("%-28s %9s %8s %8s %10s\n", "----------------------------", "---------", "--------",
+           "--------", "----------");
+
+    emu.resetStats();
+    digits.begin();
+    ref.begin();
+    report("begin", emu, 1);
+    if (!emu.isEnabled()) {
+        printf("FAIL: %s: display not enabled\n", name);
+        failures++;
+    }
+
+    // a counter: mostly the last digit changes
+    const char *scenarios[] = {"counter", "full write"};
+    for (int s = 0; s < 2; s++) {
+        emu.resetStats();
+        for (long i = 0; i < 100; i++) {
+            char szBuffer[24];
+            snprintf(szBuffer, sizeof(szBuffer), "%ld.%ld", 4711 + i / 10, i % 10);
+            digits.printFormatted(0, 0, width, 2, szBuffer);
+            if (s) {
+                digits.invalidate();
+            }
+            digits.write();
+            ref.printFormatted(0, 0, width, 2, szBuffer);
+            ref.invalidate();
+            ref.write();
+            verify(scenarios[s], emu, refEmu);
+        }
+        report(scenarios[s], emu, 100);
+    }
+
+    // text changing completely
+    emu.resetStats();
+    for (int i = 0; i < 20; i++) {
+        const char *text = i & 1 ? "HELLO WORLD" : "mupplet 0.9";
+        digits.printFormatted(0, 0, width, 1, text);
+        digits.write();
+        ref.printFormatted(0, 0, width, 1, text);
+        ref.invalidate();
+        ref.write();
+        verify("text", emu, refEmu);
+    }
+    report("text", emu, 20);
+
+    // power save
+    digits.setPowerSave(true);
+    if (emu.isEnabled()) {
+        printf("FAIL: %s: display not disabled\n", name);
+        failures++;
+    }
+    digits.setPowerSave(false);
+    printf("\n");
+}
+
+static uint16_t rawDigit(const Ht162xEmulator &emu, uint8_t digit) {
+    uint16_t pattern = 0;
+    for (uint8_t nibble = 0; nibble < 4; nibble++) {
+        pattern |= emu.getNibble(digit * 4 + nibble) << (nibble * 4);
+    }
+    return pattern;
+}
+
+static void checkDots() {
+    // the decimal dots of the 16 segment glass are located in raw digit 11
+    Ht162xEmulator emu(10, 11, 12);
+    Ht162xDigits digits(Ht162xDigits::lcd10digit_16segment, 10, 11, 12);
+    digits.begin();
+    digits.printFormatted(0, 0, 10, 0, "1.2.3");
+    digits.write();
+    if (rawDigit(emu, 0) != ustd::ht1622Font16Seg['1' - 0x20] ||
+        rawDigit(emu, 2) != ustd::ht1622Font16Seg['3' - 0x20] || rawDigit(emu, 11) != 0x0003) {
+        printf("FAIL: 16 segment text with decimal dots\n");
+        failures++;
+    }
+    digits.printNumber(0, 0, 10, -12345, 3);
+    digits.write();
+    if (rawDigit(emu, 9) != ustd::ht1622Font16Seg['5' - 0x20] || rawDigit(emu, 11) != 0x0040) {
+        printf("FAIL: 16 segment number with decimal dot\n");
+        failures++;
+    }
+    digits.printFormatted(0, 0, 10, 2, "9.");
+    digits.write();
+    if (rawDigit(emu, 9) != ustd::ht1622Font16Seg['9' - 0x20] || rawDigit(emu, 11) != 0) {
+        printf("FAIL: 16 segment dot after the last digit\n");
+        failures++;
+    }
+}
+
+static void checkFont7Seg() {
+    // the HT1621 tables must be the remapped MAX72XX tables
+    for (uint8_t variant = 0; variant < 2; variant++) {
+        for (uint8_t c = 0; c < 96; c++) {
+            if (ustd::ht1621Font7Seg[variant][c] !=
+                ustd::seg7ToHt1621(ustd::max72xxFont7Seg[variant][c])) {
+                printf("FAIL: HT1621 7 segment font %d: glyph of 0x%02X differs\n", variant,
+                       c + 0x20);
+                failures++;
+            }
+        }
+    }
+    // the alternate glyphs must be distinguishable from the glyphs they are confused with
+    const char pairs[][2] = {{'K', 'H'}, {'M', 'N'}, {'W', 'V'}, {'X', 'H'},
+                             {'k', 'h'}, {'m', 'n'}, {'w', 'v'}, {'x', 'h'}};
+    const uint8_t *alternate = ustd::max72xxFont7Seg[ustd::font7SegAlternate];
+    for (uint8_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        if (alternate[pairs[i][0] - 0x20] == alternate[pairs[i][1] - 0x20]) {
+            printf("FAIL: alternate 7 segment glyph of '%c' equals '%c'\n", pairs[i][0],
+                   pairs[i][1]);
+            failures++;
+        }
+    }
+    // and from any other character except the other case of the same letter
+    for (uint8_t c = 0; c < 96; c++) {
+        if (alternate[c] == ustd::max72xxFont7Seg[ustd::font7SegStandard][c]) {
+            continue;
+        }
+        uint8_t otherCase = ((c + 0x20) ^ 0x20) - 0x20;
+        for (uint8_t other = 0; other < 96; other++) {
+            if (other != c && other != otherCase && alternate[other] == alternate[c]) {
+                printf("FAIL: alternate 7 segment glyph of '%c' equals '%c'\n", c + 0x20,
+                       other + 0x20);
+                failures++;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (!strcmp(argv[i], "--bit")) {
+            bitTime = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--overhead")) {
+            frameOverhead = atof(argv[++i]);
+        }
+    }
+    benchType(Ht162xDigits::lcd12digit_7segment, "HT1621 7 segment LCD");
+    benchType(Ht162xDigits::lcd10digit_16segment, "HT1622 16 segment LCD");
+    checkDots();
+    checkFont7Seg();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
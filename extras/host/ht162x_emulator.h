@@ -0,0 +1,168 @@
+// ht162x_emulator.h - bit counting emulator of a HT1621/HT1622 LCD controller
+
+#pragma once
+
+#include "Arduino.h"
+
+namespace host {
+
+/*! \brief Emulator of a HT1621 or HT1622 RAM mapping LCD controller
+ *
+ * The emulator listens to GPIO writes on the configured chip select, write clock and data pins.
+ * Like the real hardware, a bit is sampled on every rising edge of the WR line while CS is low.
+ * The first 3 bits of a frame select the mode: `100` is followed by 9 bit commands, `101` by a 6
+ * bit address and any number of 4 bit data nibbles (LSB first) written to successive addresses.
+ *
+ * Besides the display RAM, the emulator counts the clocked bits, the chip select frames and the
+ * written nibbles, which allows to estimate the time spent bit banging.
+ */
+class Ht162xEmulator : public Device {
+  public:
+    /*! The statistic counters of the emulated controller */
+    typedef struct {
+        unsigned long bits;      ///< Bits clocked into the controller
+        unsigned long frames;    ///< Chip select frames
+        unsigned long nibbles;   ///< Display RAM nibbles written
+        unsigned long commands;  ///< Commands received
+    } Stats;
+
+  protected:
+    uint8_t csPin;
+    uint8_t wrPin;
+    uint8_t dataPin;
+    bool selected;
+    bool clock;
+    bool data;
+    uint8_t mode;
+    uint16_t frameBits;
+    uint16_t shift;
+    uint8_t address;
+    bool enabled;
+    uint8_t ram[64];
+    Stats stats;
+
+  public:
+    /*! Instantiate a HT162x emulator
+     * @param csPin     The chip select pin the controller is connected to
+     * @param wrPin     The write clock pin the controller is connected to
+     * @param dataPin   The data pin the controller is connected to
+     */
+    Ht162xEmulator(uint8_t csPin, uint8_t wrPin, uint8_t dataPin)
+        : csPin(csPin), wrPin(wrPin), dataPin(dataPin), selected(false), clock(true), data(false),
+          mode(0), frameBits(0), shift(0), address(0), enabled(false) {
+        memset(ram, 0, sizeof(ram));
+        resetStats();
+    }
+
+    /*! Reset the statistic counters */
+    void resetStats() {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    /*! Get the statistic counters
+     * @return The statistic counters accumulated since the last call to `resetStats()`
+     */
+    const Stats &getStats() const {
+        return stats;
+    }
+
+    /*! Get the content of a display RAM nibble
+     * @param address   Display RAM address (0..63)
+     * @return          The content of the nibble
+     */
+    uint8_t getNibble(uint8_t address) const {
+        return ram[address & 0x3f];
+    }
+
+    /*! Check if the system oscillator and the LCD bias generator are turned on */
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /*! Estimate the time spent bit banging
+     * @param bitTime       Time in microseconds needed to clock a bit
+     * @param frameOverhead Additional time in microseconds consumed by each chip select frame
+     * @return              Estimated bus time in microseconds
+     */
+    double getBusTime(double bitTime, double frameOverhead) const {
+        return (double)stats.bits * bitTime + (double)stats.frames * frameOverhead;
+    }
+
+    virtual void onPinWrite(uint8_t pin, uint8_t value) {
+        if (pin == dataPin) {
+            data = value != LOW;
+        } else if (pin == csPin) {
+            if (value == LOW) {
+                selected = true;
+                mode = 0;
+                frameBits = 0;
+                shift = 0;
+            } else if (selected) {
+                selected = false;
+                stats.frames++;
+            }
+        } else if (pin == wrPin) {
+            if (value != LOW && !clock && selected) {
+                clockIn();
+            }
+            clock = value != LOW;
+        }
+    }
+
+  protected:
+    void clockIn() {
+        stats.bits++;
+        frameBits++;
+        if (frameBits <= 3) {
+            // mode ID
+            mode = (mode << 1) | (data ? 1 : 0);
+            if (frameBits == 3) {
+                mode &= 0x07;
+                shift = 0;
+            }
+            return;
+        }
+        if (mode == 0b100) {
+            // 9 bit commands
+            shift = (shift << 1) | (data ? 1 : 0);
+            if ((frameBits - 3) % 9 == 0) {
+                command(shift & 0x1ff);
+                shift = 0;
+            }
+        } else if (mode == 0b101) {
+            if (frameBits <= 9) {
+                // 6 bit address
+                shift = (shift << 1) | (data ? 1 : 0);
+                if (frameBits == 9) {
+                    address = shift & 0x3f;
+                    shift = 0;
+                }
+            } else {
+                // data nibbles with auto increment
+                uint8_t bit = (frameBits - 10) & 3;
+                shift |= (data ? 1 : 0) << bit;
+                if (bit == 3) {
+                    ram[address] = shift & 0x0f;
+                    address = (address + 1) & 0x3f;
+                    shift = 0;
+                    stats.nibbles++;
+                }
+            }
+        }
+    }
+
+    void command(uint16_t code) {
+        stats.commands++;
+        switch (code & 0x1fe) {
+        case 0x00:  // SYS DIS
+        case 0x04:  // LCD OFF
+            enabled = false;
+            break;
+        case 0x06:  // LCD ON
+            enabled = true;
+            break;
+        }
+    }
+};
+
+}  // namespace host
@@ -0,0 +1,798 @@
+// max72xx_bench.cpp - host benchmark and regression check of the MAX72XX drivers
+//
+// Build and run on a development host:
+//
+//     g++ -std=c++11 -O2 -Wall -I extras/host -I src extras/host/max72xx_bench.cpp -o max72xx_bench
+//     ./max72xx_bench [--clock <hz>] [--overhead <us>] [--modules <n>]
+//
+// The benchmark drives `Max72xxMatrix` and `Max72xxDigits` against the MAX7219 chain emulator and reports the bus
+// traffic caused by typical display operations. Every operation is additionally rendered into a
+// reference canvas and the content of the emulated device registers is compared with it. The
+// program exits with a non-zero exit code if the emulated display does not show the expected
+// content.
+
+#include <chrono>
+
+#include "Arduino.h"
+#include "max72xx_emulator.h"
+#include "hardware/max72xx_matrix.h"
+#include "hardware/max72xx_digits.h"
+
+using ustd::Max72xxDigits;
+using ustd::Max72xxMatrix;
+using host::Max72xxEmulator;
+
+static const uint8_t csPin = 15;
+
+// benchmark parameters
+static double clockHz = 1000000.0;
+static double frameOverhead = 2.0;
+static uint8_t modules = 12;
+static int failures = 0;
+
+// synthetic GFX font derived from the classic font
+static uint8_t benchFontBitmaps[95 * 5];
+static GFXglyph benchFontGlyphs[95];
+static GFXfont benchFont = {benchFontBitmaps, benchFontGlyphs, 0x20, 0x7e, 8};
+
+static void initBenchFont() {
+    // 5x7 glyphs, rows packed MSB first as in GFX fonts
+    for (uint8_t c = 0; c < 95; c++) {
+        uint8_t *pDst = benchFontBitmaps + c * 5;
+        uint8_t bit = 0;
+        memset(pDst, 0, 5);
+        for (uint8_t y = 0; y < 7; y++) {
+            for (uint8_t x = 0; x < 5; x++, bit++) {
+                if (font[(c + 0x20) * 5 + x] & (1 << y)) {
+                    pDst[bit >> 3] |= 0x80 >> (bit & 7);
+                }
+            }
+        }
+        benchFontGlyphs[c].bitmapOffset = c * 5;
+        benchFontGlyphs[c].width = c ? 5 : 0;
+        benchFontGlyphs[c].height = c ? 7 : 0;
+        benchFontGlyphs[c].xAdvance = 6;
+        benchFontGlyphs[c].xOffset = 0;
+        benchFontGlyphs[c].yOffset = -7;
+    }
+}
+
+// reference implementation of Max72xxMatrix::printFormatted operating on a canvas
+static bool printFormatted(GFXcanvas1 &ref, int16_t x, int16_t y, int16_t w, int16_t align,
+                           String content, uint8_t baseLine, uint8_t yAdvance = 0) {
+    int16_t xx = 0, yy = 0;
+    uint16_t ww = 0, hh = 0;
+    ref.setTextWrap(false);
+    ref.getTextBounds(content, 0, 0, &xx, &yy, &ww, &hh);
+    switch (align) {
+    default:
+    case 0:
+        xx = 0;
+        break;
+    case 1:
+        xx = (w - ww) / 2;
+        break;
+    case 2:
+        xx = w - ww;
+        break;
+    }
+    if (yAdvance && (hh % yAdvance)) {
+        hh = ((hh / yAdvance) + 1) * yAdvance;
+    }
+    GFXcanvas1 tmp(w, hh);
+    tmp.setFont(&benchFont);
+    tmp.fillScreen(0);
+    tmp.setTextWrap(false);
+    tmp.setCursor(xx, baseLine ? baseLine : -1 * yy);
+    tmp.setTextColor(1, 0);
+    tmp.print(content);
+    ref.drawBitmap(x, y, tmp.getBuffer(), w, hh, 1, 0);
+    return w >= (int16_t)ww;
+}
+
+static bool printFormatted(Max72xxMatrix &matrix, int16_t x, int16_t y, int16_t w, int16_t align,
+                           String content, uint8_t baseLine, uint8_t yAdvance = 0) {
+    return matrix.printFormatted(x, y, w, align, content, baseLine, yAdvance);
+}
+
+/*! \brief A matrix under test together with its emulated chain and reference canvas */
+class Bench {
+  public:
+    uint8_t hDisplays;
+    uint8_t vDisplays;
+    uint8_t *positions;
+    uint8_t *rotations;
+    Max72xxEmulator emu;
+    Max72xxMatrix matrix;
+    GFXcanvas1 ref;
+
+    Bench(uint8_t hDisplays, uint8_t vDisplays, uint8_t rotation)
+        : hDisplays(hDisplays), vDisplays(vDisplays), emu(csPin, hDisplays * vDisplays),
+          matrix(csPin, hDisplays, vDisplays, rotation), ref(hDisplays * 8, vDisplays * 8) {
+        positions = new uint8_t[hDisplays * vDisplays];
+        rotations = new uint8_t[hDisplays * vDisplays];
+        for (uint8_t i = 0; i < hDisplays * vDisplays; i++) {
+            positions[i] = i;
+            rotations[i] = rotation;
+        }
+        matrix.setFont(&benchFont);
+        matrix.setTextColor(1, 0);
+        matrix.setTextWrap(false);
+        ref.setFont(&benchFont);
+        ref.setTextColor(1, 0);
+        ref.setTextWrap(false);
+    }
+
+    ~Bench() {
+        delete[] positions;
+        delete[] rotations;
+    }
+
+    void setPosition(uint8_t display, uint8_t x, uint8_t y) {
+        matrix.setPosition(display, x, y);
+        positions[x + hDisplays * y] = display;
+    }
+
+    void setRotation(uint8_t display, uint8_t rotation) {
+        matrix.setRotation(display, rotation);
+        rotations[display] = rotation;
+    }
+
+    // compares the emulated device registers with the reference canvas
+    bool verify(const char *scenario) {
+        // compare in physical coordinates
+        uint8_t rotation = ref.getRotation();
+        ref.setRotation(0);
+        bool result = compare(scenario);
+        ref.setRotation(rotation);
+        return result;
+    }
+
+    bool compare(const char *scenario) {
+        for (int16_t y = 0; y < vDisplays * 8; y++) {
+            for (int16_t x = 0; x < hDisplays * 8; x++) {
+                uint8_t display = positions[(x >> 3) + hDisplays * (y >> 3)];
+                uint8_t r = rotations[display];
+                uint8_t px = x & 7, py = y & 7, tmp;
+                if (r >= 2) {
+                    px = 7 - px;
+                }
+                if (r == 1 || r == 2) {
+                    py = 7 - py;
+                }
+                if (r & 1) {
+                    tmp = px;
+                    px = py;
+                    py = tmp;
+                }
+                bool shown = emu.getRegister(display, ustd::Max72XX::digit0 + px) & (1 << py);
+                if (shown != ref.getPixel(x, y)) {
+                    printf("FAIL: %s: pixel %d,%d differs (display %d)\n", scenario, x, y,
+                           display);
+                    failures++;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static void report(const char *scenario, const Max72xxEmulator &emu, unsigned long writes) {
+    const Max72xxEmulator::Stats &stats = emu.getStats();
+    double n = writes ? writes : 1;
+    printf("%-28s %9.1f %8.2f %8.1f %8.1f %10.1f\n", scenario, stats.bytes / n, stats.frames / n,
+           stats.latches / n, stats.noops / n, emu.getBusTime(clockHz, frameOverhead) / n);
+    if (stats.unaligned) {
+        printf("FAIL: %s: %lu frames not aligned to 16 bit words\n", scenario, stats.unaligned);
+        failures++;
+    }
+}
+
+static void benchSign() {
+    Bench bench(modules, 1, 1);
+    Max72xxMatrix &matrix = bench.matrix;
+    Max72xxEmulator &emu = bench.emu;
+    int16_t width = matrix.width();
+
+    printf("Sign with %d modules (%dx8 pixels), SPI clock %.0f Hz, %.1f us per frame\n\n", modules,
+           width, clockHz, frameOverhead);
+    printf("%-28s %9s %8s %8s %8s %10s\n", "scenario (per write)", "bytes", "frames", "latches",
+           "noops", "bus us");
+    printf("%-28s %9s %8s %8s %8s %10s\n", "----------------------------", "---------",
+           "--------", "--------", "--------", "----------");
+
+    emu.resetStats();
+    matrix.begin();
+    bench.verify("begin");
+    report("begin", emu, 1);
+
+    // full redraw with random content
+    srand(4711);
+    emu.resetStats();
+    for (int i = 0; i < 16; i++) {
+        for (int16_t y = 0; y < 8; y++) {
+            for (int16_t x = 0; x < width; x++) {
+                uint16_t color = rand() & 1;
+                matrix.drawPixel(x, y, color);
+                bench.ref.drawPixel(x, y, color);
+            }
+        }
+        matrix.write();
+        bench.verify("full redraw");
+    }
+    report("full redraw", emu, 16);
+
+    // flush without any change
+    emu.resetStats();
+    for (int i = 0; i < 16; i++) {
+        matrix.write();
+    }
+    bench.verify("idle flush");
+    report("idle flush", emu, 16);
+
+    // single pixel toggles
+    emu.resetStats();
+    for (int i = 0; i < 64; i++) {
+        int16_t x = rand() % width, y = rand() % 8;
+        uint16_t color = bench.ref.getPixel(x, y) ? 0 : 1;
+        matrix.drawPixel(x, y, color);
+        bench.ref.drawPixel(x, y, color);
+        matrix.write();
+        bench.verify("single pixel");
+    }
+    report("single pixel", emu, 64);
+
+    // clear screen
+    emu.resetStats();
+    matrix.fillScreen(0);
+    bench.ref.fillScreen(0);
+    matrix.write();
+    bench.verify("clear");
+    report("clear", emu, 1);
+
+    // a clock showing seconds
+    emu.resetStats();
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "12:34:%2.2i", s);
+        printFormatted(matrix, 0, 0, width, 1, szBuffer, 7, 8);
+        printFormatted(bench.ref, 0, 0, width, 1, szBuffer, 7, 8);
+        matrix.write();
+        bench.verify("clock tick");
+    }
+    report("clock tick", emu, 60);
+
+    // slide in effect as performed by the program player
+    emu.resetStats();
+    unsigned long steps = 0;
+    for (int16_t slidePos = width - 1; slidePos >= 0; slidePos--, steps++) {
+        printFormatted(matrix, slidePos, 0, width - slidePos, 0, "A", 7, 8);
+        printFormatted(bench.ref, slidePos, 0, width - slidePos, 0, "A", 7, 8);
+        matrix.write();
+        bench.verify("slide in step");
+    }
+    report("slide in step", emu, steps);
+
+    // asynchronous write drained one row per step
+    emu.resetStats();
+    matrix.setAsync(true);
+    unsigned long asyncSteps = 0;
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "23:59:%2.2i", s);
+        printFormatted(matrix, 0, 0, width, 1, szBuffer, 7, 8);
+        printFormatted(bench.ref, 0, 0, width, 1, szBuffer, 7, 8);
+        matrix.write();
+        while (matrix.writeStep()) {
+            asyncSteps++;
+        }
+        asyncSteps++;
+        if (!matrix.isWriteComplete()) {
+            printf("FAIL: async write: frame not complete\n");
+            failures++;
+        }
+        bench.verify("async clock tick");
+    }
+    matrix.setAsync(false);
+    report("async clock tick", emu, 60);
+    printf("%-28s %9.1f\n", "  (steps per frame)", asyncSteps / 60.0);
+
+    // composite update as performed by the display commands: clear, then print
+    emu.resetStats();
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "%2.2i", s);
+        matrix.fillRect(0, 0, width, 8, 0);
+        matrix.write();
+        printFormatted(matrix, 0, 0, width / 2, 2, szBuffer, 7, 8);
+        matrix.write();
+        printFormatted(matrix, width / 2, 0, width / 2, 0, "sec", 7, 8);
+        matrix.write();
+    }
+    report("composite update", emu, 60);
+    emu.resetStats();
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "%2.2i", s);
+        matrix.beginFrame();
+        matrix.fillRect(0, 0, width, 8, 0);
+        bench.ref.fillRect(0, 0, width, 8, 0);
+        matrix.write();
+        printFormatted(matrix, 0, 0, width / 2, 2, szBuffer, 7, 8);
+        printFormatted(bench.ref, 0, 0, width / 2, 2, szBuffer, 7, 8);
+        matrix.write();
+        printFormatted(matrix, width / 2, 0, width / 2, 0, "sec", 7, 8);
+        printFormatted(bench.ref, width / 2, 0, width / 2, 0, "sec", 7, 8);
+        matrix.write();
+        matrix.endFrame();
+        bench.verify("composite frame");
+    }
+    report("composite in frame", emu, 60);
+
+    // frame pacing: continuous writes flushed at 500 frames per second
+    matrix.setFrameRate(500);
+    unsigned long start = micros(), flushes = 0;
+    while (micros() - start < 50000) {
+        matrix.drawPixel(rand() % width, rand() % 8, rand() & 1);
+        matrix.write();
+        flushes += matrix.frameStep() ? 1 : 0;
+    }
+    matrix.setFrameRate(0);
+    if (flushes > 26) {
+        printf("FAIL: frame pacing: %lu flushes in 50 ms at 500 fps\n", flushes);
+        failures++;
+    }
+
+    // light controller update
+    emu.resetStats();
+    for (int i = 0; i < 16; i++) {
+        matrix.setIntensity(8);
+        matrix.setPowerSave(false);
+    }
+    report("light update", emu, 16);
+
+    // individual module brightness
+    emu.resetStats();
+    for (uint8_t display = 0; display < modules; display++) {
+        matrix.setIntensity(display, display & 15);
+    }
+    for (uint8_t display = 0; display < modules; display++) {
+        if (emu.getRegister(display, ustd::Max72XX::intensity) != (display & 15)) {
+            printf("FAIL: module intensity: display %d has wrong intensity\n", display);
+            failures++;
+        }
+    }
+    report("module intensity", emu, modules);
+    printf("\n");
+}
+
+static void benchLayout(bool logical) {
+    // a 4x2 layout with mixed module order and rotations
+    Bench bench(4, 2, 0);
+    bench.matrix.setLogicalLayout(logical);
+    uint8_t order[8] = {3, 1, 6, 0, 7, 2, 5, 4};
+    for (uint8_t i = 0; i < 8; i++) {
+        bench.setPosition(order[i], i % 4, i / 4);
+        bench.setRotation(i, i & 3);
+    }
+    bench.matrix.begin();
+    bench.verify("layout begin");
+    srand(815);
+    uint8_t source[3 * 10];
+    ustd::Max72xxStrip strip(60, 12);
+    strip.setFont(&benchFont);
+    strip.setTextColor(1, 0);
+    strip.setCursor(1, 7);
+    strip.print("Strip 0123456789");
+    for (uint8_t r = 0; r < 4; r++) {
+        // Adafruit's display rotation (hidden by Max72xxMatrix::setRotation(display, rotation))
+        static_cast<Adafruit_GFX &>(bench.matrix).setRotation(r);
+        bench.ref.setRotation(r);
+        for (int i = 0; i < 32; i++) {
+            int16_t x = rand() % 32, y = rand() % 32, w = rand() % 24 - 4, h = rand() % 16 - 4;
+            uint16_t color = rand() & 1;
+            // Adafruit_GFX::fillRect() does not handle negative widths
+            bench.matrix.fillRect(x, y, abs(w), h, color);
+            bench.ref.fillRect(x, y, abs(w), h, color);
+            bench.matrix.drawLine(x, y, w, h, !color);
+            bench.ref.drawLine(x, y, w, h, !color);
+            bench.matrix.drawFastHLine(y, x, w, color);
+            bench.ref.drawFastHLine(y, x, w, color);
+            bench.matrix.drawFastVLine(h, w, y, !color);
+            bench.ref.drawFastVLine(h, w, y, !color);
+            for (uint8_t b = 0; b < sizeof(source); b++) {
+                source[b] = rand() & rand();
+            }
+            w = rand() % 24;
+            h = rand() % 10;
+            if (i & 1) {
+                bench.matrix.drawBitmap(x - 8, y - 8, source, w, h, color, !color);
+                bench.ref.drawBitmap(x - 8, y - 8, source, w, h, color, !color);
+            } else {
+                bench.matrix.drawBitmap(x - 8, y - 8, source, w, h, color);
+                bench.ref.drawBitmap(x - 8, y - 8, source, w, h, color);
+            }
+            // a window of an off-screen strip at a byte aligned or unaligned position
+            h = (i & 2) ? y & ~7 : y;
+            w = rand() % 40;
+            int16_t offset = rand() % 80 - 20;
+            bench.matrix.drawStrip(x - 8, h - 8, w, strip, offset, color, !color);
+            for (int16_t sx = 0; sx < w; sx++) {
+                for (int16_t sy = 0; sy < strip.height(); sy++) {
+                    bool set = strip.getColumn(offset + sx, sy >> 3) & (1 << (sy & 7));
+                    bench.ref.drawPixel(x - 8 + sx, h - 8 + sy, set ? color : !color);
+                }
+            }
+            bench.matrix.write();
+            bench.verify("layout draw");
+        }
+    }
+    static_cast<Adafruit_GFX &>(bench.matrix).setRotation(0);
+    bench.ref.setRotation(0);
+    printf("Layout check (4x2 modules, mixed order and rotation%s): %s\n\n",
+           logical ? ", logical layout" : "", failures ? "FAILED" : "OK");
+}
+
+static void checkChainLimits() {
+    // configurations exceeding the chain length or the number of units must be rejected
+    const uint8_t csPins[8] = {31, 32, 33, 34, 35, 36, 37, 38};
+    const struct {
+        uint8_t chains, hDisplays, vDisplays;
+        bool valid;
+    } configs[] = {
+        {4, 48, 2, false}, {6, 48, 2, true}, {1, 48, 1, false},
+        {3, 48, 1, true},  {8, 16, 16, false}, {1, 16, 1, true},
+    };
+    for (uint8_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        Max72xxMatrix matrix(configs[i].chains, csPins, configs[i].hDisplays,
+                             configs[i].vDisplays);
+        if (matrix.begin() != configs[i].valid) {
+            printf("FAIL: %dx%d modules on %d chains %s\n", configs[i].hDisplays,
+                   configs[i].vDisplays, configs[i].chains,
+                   configs[i].valid ? "rejected" : "accepted");
+            failures++;
+        }
+    }
+}
+
+static void benchShards() {
+    // a 32x2 modules sign split into 4 chains of 16 modules
+    const uint8_t chains = 4, hDisplays = 32, vDisplays = 2, chainLen = 16;
+    const uint8_t csPins[chains] = {21, 22, 23, 24};
+    Max72xxEmulator *emus[chains];
+    for (uint8_t chain = 0; chain < chains; chain++) {
+        emus[chain] = new Max72xxEmulator(csPins[chain], chainLen);
+    }
+    Max72xxMatrix matrix(chains, csPins, hDisplays, vDisplays);
+    GFXcanvas1 ref(hDisplays * 8, vDisplays * 8);
+    int16_t width = matrix.width(), height = matrix.height();
+    matrix.setFont(&benchFont);
+    matrix.setTextColor(1, 0);
+    ref.setFont(&benchFont);
+    ref.setTextColor(1, 0);
+    matrix.begin();
+
+    double sharedBus = 0, longestChain = 0;
+    srand(1234);
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "12:34:%2.2i", s);
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            emus[chain]->resetStats();
+        }
+        printFormatted(matrix, 0, 0, width, 1, szBuffer, 7, 8);
+        printFormatted(ref, 0, 0, width, 1, szBuffer, 7, 8);
+        int16_t x = rand() % width, y = 8 + rand() % 8;
+        matrix.drawPixel(x, y, 1);
+        ref.drawPixel(x, y, 1);
+        matrix.write();
+        double longest = 0;
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            double busTime = emus[chain]->getBusTime(clockHz, frameOverhead);
+            sharedBus += busTime;
+            longest = busTime > longest ? busTime : longest;
+        }
+        longestChain += longest;
+    }
+    for (int16_t y = 0; y < height; y++) {
+        for (int16_t x = 0; x < width; x++) {
+            uint16_t display = (x >> 3) + hDisplays * (y >> 3);
+            bool shown = emus[display / chainLen]->getRegister(
+                             display % chainLen, ustd::Max72XX::digit0 + (x & 7)) &
+                         (1 << (y & 7));
+            if (shown != ref.getPixel(x, y)) {
+                printf("FAIL: shards: pixel %d,%d differs (display %d)\n", x, y, display);
+                failures++;
+                y = height;
+                break;
+            }
+        }
+    }
+    printf("Sharded sign (%dx%d modules on %d chains), per clock tick: %.1f us on a shared bus, "
+           "%.1f us on separate busses\n\n",
+           hDisplays, vDisplays, chains, sharedBus / 60, longestChain / 60);
+    for (uint8_t chain = 0; chain < chains; chain++) {
+        delete emus[chain];
+    }
+}
+
+static void benchDigits() {
+    // a clock on 4 modules of 8 digits compared with a reference chain that is always fully written
+    const uint8_t hDisplays = 4, refPin = 25;
+    Max72xxEmulator emu(csPin, hDisplays), refEmu(refPin, hDisplays);
+    Max72xxDigits digits(csPin, hDisplays), ref(refPin, hDisplays);
+    digits.begin();
+    ref.begin();
+
+    emu.resetStats();
+    refEmu.resetStats();
+    digits.resetSkippedFrames();
+    for (int s = 0; s < 60; s++) {
+        char szBuffer[24];
+        snprintf(szBuffer, sizeof(szBuffer), "12-34-%2.2i", s);
+        digits.printFormatted(0, 0, digits.width(), 2, szBuffer);
+        digits.write();
+        ref.printFormatted(0, 0, ref.width(), 2, szBuffer);
+        ref.invalidate();
+        ref.write();
+    }
+    for (uint8_t device = 0; device < hDisplays; device++) {
+        for (uint8_t digit = ustd::Max72XX::digit0; digit <= ustd::Max72XX::digit7; digit++) {
+            if (emu.getRegister(device, digit) != refEmu.getRegister(device, digit)) {
+                printf("FAIL: digits: device %d digit register %d differs\n", device, digit);
+                failures++;
+            }
+        }
+    }
+    const Max72xxEmulator::Stats &stats = emu.getStats();
+    printf("Digits clock (%d modules, %d digits), per clock tick: %.1f bytes, %.2f frames, %.2f "
+           "skipped frames, %.1f us (full write: %.1f us)\n\n",
+           hDisplays, digits.width(), stats.bytes / 60.0, stats.frames / 60.0,
+           digits.getSkippedFrames() / 60.0, emu.getBusTime(clockHz, frameOverhead) / 60,
+           refEmu.getBusTime(clockHz, frameOverhead) / 60);
+}
+
+/*! \brief A frame buffer using the original per pixel address translation of Max72xxMatrix */
+class LegacyMatrix : public Adafruit_GFX {
+  public:
+    uint8_t hDisplays;
+    const uint8_t *positions;
+    const uint8_t *rotations;
+    uint8_t bitmap[64];
+
+    LegacyMatrix(uint8_t hDisplays, uint8_t vDisplays, const uint8_t *positions,
+                 const uint8_t *rotations)
+        : Adafruit_GFX(hDisplays << 3, vDisplays << 3), hDisplays(hDisplays),
+          positions(positions), rotations(rotations) {
+        memset(bitmap, 0, sizeof(bitmap));
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        uint8_t tmp;
+        if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) {
+            return;
+        }
+        uint8_t display = positions[(x >> 3) + hDisplays * (y >> 3)];
+        x &= 0b111;
+        y &= 0b111;
+        uint8_t r = rotations[display];
+        if (r >= 2) {
+            x = 7 - x;
+        }
+        if (r == 1 || r == 2) {
+            y = 7 - y;
+        }
+        if (r & 1) {
+            tmp = x;
+            x = y;
+            y = tmp;
+        }
+        uint8_t d = display / hDisplays;
+        x += (display - d * hDisplays) << 3;
+        y += d << 3;
+        uint8_t *ptr = bitmap + x + WIDTH * (y >> 3);
+        uint8_t val = 1 << (y & 0b111);
+        if (color) {
+            *ptr |= val;
+        } else {
+            *ptr &= ~val;
+        }
+    }
+};
+
+// draws a pattern pixel by pixel through the GFX interface - returns the best time of 3 runs
+static double drawPattern(Adafruit_GFX &gfx, long passes) {
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long pass = 0; pass < passes; pass++) {
+            for (int16_t y = 0; y < gfx.height(); y++) {
+                for (int16_t x = 0; x < gfx.width(); x++) {
+                    gfx.drawPixel(x, y, (x ^ y ^ pass) & 1);
+                }
+            }
+        }
+        double time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 || time < best ? time : best;
+    }
+    return best;
+}
+
+// clears the display through fillRect - returns the best time of 3 runs
+static double clearScreen(Adafruit_GFX &gfx, long passes) {
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long pass = 0; pass < passes; pass++) {
+            gfx.fillRect(0, 0, gfx.width(), gfx.height(), pass & 1);
+        }
+        double time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 || time < best ? time : best;
+    }
+    return best;
+}
+
+// flushes an unchanged frame - returns the best time of 3 runs
+static double flushFrame(Max72xxMatrix &matrix, long passes) {
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long pass = 0; pass < passes; pass++) {
+            matrix.write();
+        }
+        double time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 || time < best ? time : best;
+    }
+    return best;
+}
+
+static void benchPixels() {
+    // pixel throughput on a 4x2 layout with mixed module order and rotations
+    Bench bench(4, 2, 0);
+    uint8_t order[8] = {3, 1, 6, 0, 7, 2, 5, 4};
+    for (uint8_t i = 0; i < 8; i++) {
+        bench.setPosition(order[i], i % 4, i / 4);
+        bench.setRotation(i, i & 3);
+    }
+    bench.matrix.begin();
+    LegacyMatrix legacy(4, 2, bench.positions, bench.rotations);
+    const long passes = 100000;
+    double pixels = passes * 512.0;
+
+    double legacyTime = drawPattern(legacy, passes);
+    double matrixTime = drawPattern(bench.matrix, passes);
+
+    // the display must show the pattern of the last pass
+    for (int16_t y = 0; y < 16; y++) {
+        for (int16_t x = 0; x < 32; x++) {
+            bench.ref.drawPixel(x, y, (x ^ y ^ (passes - 1)) & 1);
+        }
+    }
+    bench.matrix.write();
+    bench.verify("pixel throughput");
+
+    double legacyClear = clearScreen(legacy, passes);
+    double matrixClear = clearScreen(bench.matrix, passes);
+    bench.ref.fillScreen((passes - 1) & 1);
+    bench.matrix.write();
+    bench.verify("clear throughput");
+
+    // the same layout with the frame buffer kept in logical layout
+    Bench logical(4, 2, 0);
+    for (uint8_t i = 0; i < 8; i++) {
+        logical.setPosition(order[i], i % 4, i / 4);
+        logical.setRotation(i, i & 3);
+    }
+    logical.matrix.setLogicalLayout(true);
+    logical.matrix.begin();
+    double logicalTime = drawPattern(logical.matrix, passes);
+    double flushTime = flushFrame(bench.matrix, passes);
+    double logicalFlushTime = flushFrame(logical.matrix, passes);
+    for (int16_t y = 0; y < 16; y++) {
+        for (int16_t x = 0; x < 32; x++) {
+            logical.ref.drawPixel(x, y, (x ^ y ^ (passes - 1)) & 1);
+        }
+    }
+    logical.matrix.write();
+    logical.verify("logical pixel throughput");
+
+    printf("Pixel throughput (4x2 modules, mixed order and rotation):\n");
+    printf("  per pixel translation   %8.1f Mpixels/s\n", pixels / legacyTime / 1e6);
+    printf("  lookup table            %8.1f Mpixels/s\n", pixels / matrixTime / 1e6);
+    printf("  logical layout          %8.1f Mpixels/s\n", pixels / logicalTime / 1e6);
+    printf("Unchanged frame flush (4x2 modules, mixed order and rotation):\n");
+    printf("  physical layout         %8.3f us\n", flushTime * 1e6 / passes);
+    printf("  logical layout          %8.3f us\n", logicalFlushTime * 1e6 / passes);
+    printf("Clear through fillRect (4x2 modules, mixed order and rotation):\n");
+    printf("  per pixel               %8.1f Mpixels/s\n", pixels / legacyClear / 1e6);
+    printf("  byte operations         %8.1f Mpixels/s\n\n", pixels / matrixClear / 1e6);
+}
+
+static void benchGrayscale() {
+    printf("Grayscale frame budget (random content, SPI clock %.0f Hz, %.1f us per frame):\n\n",
+           clockHz, frameOverhead);
+    printf("%-8s %10s %12s %12s %12s\n", "modules", "plane us", "2 bit Hz", "3 bit Hz",
+           "4 bit Hz");
+    printf("%-8s %10s %12s %12s %12s\n", "--------", "----------", "------------",
+           "------------", "------------");
+    const uint8_t chainLens[] = {1, 2, 4, 8, 12, 16};
+    for (uint8_t i = 0; i < sizeof(chainLens); i++) {
+        Bench bench(chainLens[i], 1, 1);
+        Max72xxMatrix &matrix = bench.matrix;
+        int16_t width = matrix.width();
+        matrix.begin();
+        double planeTime = 0;
+        for (uint8_t bits = 2; bits <= 4; bits++) {
+            matrix.setGrayscale(bits);
+            uint8_t *levels = new uint8_t[width * 8];
+            srand(bits);
+            for (int16_t y = 0; y < 8; y++) {
+                for (int16_t x = 0; x < width; x++) {
+                    levels[x + y * width] = rand() & ((1 << bits) - 1);
+                    matrix.drawPixel(x, y, levels[x + y * width]);
+                }
+            }
+            matrix.write();
+            bench.emu.resetStats();
+            // one full cycle: every plane switch must show the bits of the plane
+            uint8_t plane = bits - 1;
+            for (int step = 0; step < (1 << bits) - 1; step++) {
+                if (matrix.grayStep()) {
+                    plane = (plane + 1) % bits;
+                    for (int16_t y = 0; y < 8; y++) {
+                        for (int16_t x = 0; x < width; x++) {
+                            bench.ref.drawPixel(x, y,
+                                                levels[x + y * width] & (1 << (bits - 1 - plane)));
+                        }
+                    }
+                    bench.verify("grayscale plane");
+                }
+            }
+            if (matrix.getGrayscaleStats().planes != bits) {
+                printf("FAIL: grayscale: %lu planes transmitted in one cycle\n",
+                       matrix.getGrayscaleStats().planes);
+                failures++;
+            }
+            // worst case: every plane differs in every row
+            if (bits == 2) {
+                planeTime = bench.emu.getBusTime(clockHz, frameOverhead) / bits;
+            }
+            delete[] levels;
+        }
+        matrix.setGrayscale(0);
+        // the shortest step is the transmission time of a plane
+        printf("%-8d %10.1f %12.1f %12.1f %12.1f\n", chainLens[i], planeTime,
+               1e6 / (planeTime * 3), 1e6 / (planeTime * 7), 1e6 / (planeTime * 15));
+    }
+    printf("\nA grayscale cycle should be repeated at least 100 times per second.\n\n");
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (!strcmp(argv[i], "--clock")) {
+            clockHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--overhead")) {
+            frameOverhead = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--modules")) {
+            modules = atoi(argv[++i]);
+        }
+    }
+    initBenchFont();
+    benchSign();
+    benchLayout(false);
+    benchLayout(true);
+    checkChainLimits();
+    benchShards();
+    benchDigits();
+    benchPixels();
+    benchGrayscale();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+// max72xx_emulator.h - cycle counting emulator of a cascaded MAX7219/MAX7221 chain
+
+#pragma once
+
+#include "Arduino.h"
+
+namespace host {
+
+/*! \brief Emulator of a chain of cascaded MAX7219 or MAX7221 devices
+ *
+ * The emulator listens to GPIO writes on the configured chip select pin and to all SPI transfers
+ * performed while the chip select line is low. Like the real hardware, every device contains a
+ * 16 bit shift register whose output (DOUT) feeds the input of the next device in the chain. On
+ * the rising edge of the LOAD/CS line every device latches the content of its shift register into
+ * its register file. Device 0 is the device closest to the microcontroller.
+ *
+ * Besides the register file, the emulator counts the shifted bytes, the serial clock cycles and
+ * the chip select frames, which allows to estimate the time the SPI bus has been busy.
+ */
+class Max72xxEmulator : public Device {
+  public:
+    /*! The statistic counters of the emulated chain */
+    typedef struct {
+        unsigned long bytes;      ///< Bytes shifted into the chain
+        unsigned long cycles;     ///< Serial clock cycles
+        unsigned long frames;     ///< Chip select frames (LOAD rising edges)
+        unsigned long latches;    ///< Registers latched with a valid (non no-op) opcode
+        unsigned long noops;      ///< Registers latched with a no-op opcode
+        unsigned long unaligned;  ///< Frames whose length was not a multiple of 16 bits
+    } Stats;
+
+  protected:
+    uint8_t csPin;
+    uint8_t chainLen;
+    bool selected;
+    uint16_t *shift;
+    uint8_t *registers;
+    unsigned long frameBytes;
+    Stats stats;
+
+  public:
+    /*! Instantiate a MAX72XX chain emulator
+     * @param csPin     The chip select pin the chain is connected to
+     * @param chainLen  The number of devices in the chain
+     */
+    Max72xxEmulator(uint8_t csPin, uint8_t chainLen)
+        : csPin(csPin), chainLen(chainLen), selected(false) {
+        shift = (uint16_t *)calloc(chainLen, sizeof(uint16_t));
+        registers = (uint8_t *)calloc(chainLen, 16);
+        resetStats();
+    }
+
+    virtual ~Max72xxEmulator() {
+        free(shift);
+        free(registers);
+    }
+
+    /*! Reset the statistic counters */
+    void resetStats() {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    /*! Get the statistic counters
+     * @return The statistic counters accumulated since the last call to `resetStats()`
+     */
+    const Stats &getStats() const {
+        return stats;
+    }
+
+    /*! Get the number of devices in the chain */
+    uint8_t getChainLen() const {
+        return chainLen;
+    }
+
+    /*! Get the content of a latched register
+     * @param device    Index of the device (0 is the device closest to the microcontroller)
+     * @param reg       Register address (0..15)
+     * @return          The content of the register
+     */
+    uint8_t getRegister(uint8_t device, uint8_t reg) const {
+        return device < chainLen ? registers[device * 16 + (reg & 0x0f)] : 0;
+    }
+
+    /*! Estimate the time the SPI bus was busy
+     * @param clockHz       SPI clock frequency in Hz
+     * @param frameOverhead Additional time in microseconds consumed by each chip select frame
+     *                      (GPIO toggling, transfer setup)
+     * @return              Estimated bus time in microseconds
+     */
+    double getBusTime(double clockHz, double frameOverhead) const {
+        return (double)stats.cycles * 1000000.0 / clockHz + (double)stats.frames * frameOverhead;
+    }
+
+    virtual void onPinWrite(uint8_t pin, uint8_t value) {
+        if (pin != csPin) {
+            return;
+        }
+        if (value == LOW) {
+            selected = true;
+            frameBytes = 0;
+        } else if (selected) {
+            // rising edge on LOAD: all devices latch their shift register
+            selected = false;
+            stats.frames++;
+            if (frameBytes & 1) {
+                stats.unaligned++;
+            }
+            for (uint8_t device = 0; device < chainLen; device++) {
+                uint8_t opcode = (shift[device] >> 8) & 0x0f;
+                if (opcode) {
+                    registers[device * 16 + opcode] = shift[device] & 0xff;
+                    stats.latches++;
+                } else {
+                    stats.noops++;
+                }
+            }
+        }
+    }
+
+    virtual void onSpiTransfer(uint8_t data) {
+        if (!selected) {
+            return;
+        }
+        // shift the byte into the first device - the most significant byte of every device is
+        // shifted into the next device of the chain
+        for (int16_t device = chainLen - 1; device >= 0; device--) {
+            uint8_t in = device ? shift[device - 1] >> 8 : data;
+            shift[device] = (shift[device] << 8) | in;
+        }
+        frameBytes++;
+        stats.bytes++;
+        stats.cycles += 8;
+    }
+};
+
+}  // namespace host
@@ -0,0 +1,8 @@
+// mupplet_core.h - host replacement of the mupplet-core umbrella header
+//
+// The hardware driver classes only need the Arduino core definitions which are already provided
+// by the host version of `Arduino.h`.
+
+#pragma once
+
+#include "Arduino.h"
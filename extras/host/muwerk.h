@@ -0,0 +1,80 @@
+// muwerk.h - host replacement of the muwerk helper functions
+//
+// Provides the string parsing helpers of muwerk used by the display mupplets. The functions follow
+// the algorithms of the original.
+
+#pragma once
+
+#include <strings.h>
+
+#include "Arduino.h"
+#include "ustd_array.h"
+
+namespace ustd {
+
+String shift(String &src, char delimiter = ' ', String defValue = "") {
+    if (src.length() == 0) {
+        return defValue;
+    }
+    String ret;
+    int ind = src.indexOf(delimiter);
+    if (ind == -1) {
+        ret = src;
+        src = "";
+    } else {
+        ret = src.substring(0, ind);
+        src = src.substring(ind + 1);
+    }
+    return ret;
+}
+
+unsigned char split(String &src, char delimiter, array<String> &result) {
+    String source = src;
+    while (source.length()) {
+        result.add(shift(source, delimiter));
+    }
+    return result.length();
+}
+
+int8_t parseBoolean(String arg) {
+    arg.trim();
+    const char *pArg = arg.c_str();
+    if (!strcasecmp(pArg, "on") || !strcasecmp(pArg, "true") || !strcmp(pArg, "1")) {
+        return 1;
+    }
+    if (!strcasecmp(pArg, "off") || !strcasecmp(pArg, "false") || !strcmp(pArg, "0")) {
+        return 0;
+    }
+    return -1;
+}
+
+long parseLong(String arg, long defaultVal) {
+    arg.trim();
+    return arg.length() ? atol(arg.c_str()) : defaultVal;
+}
+
+long parseRangedLong(String arg, long minVal, long maxVal, long minDefault, long maxDefault) {
+    arg.trim();
+    if (arg.length() == 0) {
+        return minDefault;
+    }
+    long val = atol(arg.c_str());
+    if (val < minVal) {
+        return minDefault;
+    } else if (val > maxVal) {
+        return maxDefault;
+    }
+    return val;
+}
+
+int16_t parseToken(String arg, const char **tokenList, int16_t defaultVal = -1) {
+    arg.trim();
+    for (int16_t i = 0; tokenList[i]; i++) {
+        if (!strcasecmp(arg.c_str(), tokenList[i])) {
+            return i;
+        }
+    }
+    return defaultVal;
+}
+
+}  // namespace ustd
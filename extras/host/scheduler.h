@@ -0,0 +1,68 @@
+// scheduler.h - host replacement of the muwerk scheduler
+//
+// Tasks are never run. Subscriptions are stored and `publish()` delivers the message
+// synchronously to all matching subscribers. Additionally the published messages are counted
+// and the last one is recorded in order to allow the benchmarks to check replies.
+
+#pragma once
+
+#include <functional>
+
+#include "Arduino.h"
+
+namespace ustd {
+
+typedef std::function<void()> T_TASK;
+typedef std::function<void(String topic, String msg, String originator)> T_SUBS;
+
+class Scheduler {
+  protected:
+    typedef struct {
+        int taskID;
+        String topic;
+        T_SUBS subs;
+    } Subscription;
+    std::vector<Subscription> subscriptions;
+    int taskCount;
+
+  public:
+    unsigned long publishCount;
+    String lastTopic;
+    String lastMsg;
+
+    Scheduler() : taskCount(0), publishCount(0) {
+    }
+
+    int add(T_TASK task, String name, unsigned long minMicroSecs = 100000L) {
+        return ++taskCount;
+    }
+
+    int subscribe(int taskID, String topic, T_SUBS subs) {
+        subscriptions.push_back({taskID, topic, subs});
+        return (int)subscriptions.size();
+    }
+
+    bool publish(String topic, String msg = "", String originator = "") {
+        publishCount++;
+        lastTopic = topic;
+        lastMsg = msg;
+        for (size_t i = 0; i < subscriptions.size(); i++) {
+            if (match(subscriptions[i].topic, topic)) {
+                subscriptions[i].subs(topic, msg, originator);
+            }
+        }
+        return true;
+    }
+
+    static bool match(const String &pattern, const String &topic) {
+        // supports the trailing multi level wildcard `#` only. Like in MQTT it also matches the
+        // parent level itself
+        if (pattern.endsWith("/#")) {
+            String parent = pattern.substring(0, pattern.length() - 2);
+            return topic == parent || topic.startsWith(parent + "/");
+        }
+        return pattern == topic;
+    }
+};
+
+}  // namespace ustd
@@ -0,0 +1,520 @@
+// st7735_bench.cpp - host benchmark and regression check of the ST7735 matrix driver
+//
+// Build and run on a development host:
+//
+//     g++ -std=c++11 -O2 -Wall -I extras/host -I src extras/host/st7735_bench.cpp -o st7735_bench
+//     ./st7735_bench [--clock <hz>] [--overhead <us>]
+//
+// The benchmark drives `St7735Matrix` against the ST77xx emulator and reports the SPI traffic and
+// the memory needed by typical operations. The content of the emulated display RAM is compared
+// with a second emulated controller driven by the reference implementation. The program exits
+// with a non-zero exit code if they differ.
+
+#include "Arduino.h"
+#include "st7735_emulator.h"
+#include "hardware/st7735_matrix.h"
+#include "helper/indexed_canvas.h"
+
+using host::St7735Emulator;
+using ustd::IndexedCanvas;
+using ustd::St7735ClassicGlyphs;
+using ustd::St7735Matrix;
+
+// wiring of the display under test and of the reference display
+static const uint8_t csPin = 5;
+static const uint8_t dcPin = 16;
+static const uint8_t refCsPin = 25;
+static const uint8_t refDcPin = 26;
+
+// benchmark parameters
+static double clockHz = 27000000.0;
+static double frameOverhead = 2.0;
+static int failures = 0;
+
+// synthetic GFX fonts derived from the classic font: 5x7 and 10x14 pixels
+static uint8_t smallFontBitmaps[95 * 5];
+static GFXglyph smallFontGlyphs[95];
+static GFXfont smallFont = {smallFontBitmaps, smallFontGlyphs, 0x20, 0x7e, 8};
+static uint8_t largeFontBitmaps[95 * 18];
+static GFXglyph largeFontGlyphs[95];
+static GFXfont largeFont = {largeFontBitmaps, largeFontGlyphs, 0x20, 0x7e, 16};
+
+static void initBenchFont(GFXfont &gfxFont, uint8_t scale) {
+    // glyphs rows packed MSB first as in GFX fonts
+    uint8_t gw = 5 * scale, gh = 7 * scale;
+    uint16_t glyphBytes = (gw * gh + 7) / 8;
+    for (uint8_t c = 0; c < 95; c++) {
+        uint8_t *pDst = gfxFont.bitmap + c * glyphBytes;
+        uint16_t bit = 0;
+        memset(pDst, 0, glyphBytes);
+        for (uint8_t y = 0; y < gh; y++) {
+            for (uint8_t x = 0; x < gw; x++, bit++) {
+                if (font[(c + 0x20) * 5 + x / scale] & (1 << (y / scale))) {
+                    pDst[bit >> 3] |= 0x80 >> (bit & 7);
+                }
+            }
+        }
+        gfxFont.glyph[c].bitmapOffset = c * glyphBytes;
+        gfxFont.glyph[c].width = c ? gw : 0;
+        gfxFont.glyph[c].height = c ? gh : 0;
+        gfxFont.glyph[c].xAdvance = 6 * scale;
+        gfxFont.glyph[c].xOffset = 0;
+        gfxFont.glyph[c].yOffset = -gh;
+    }
+}
+
+// reference implementation of St7735Matrix::printFormatted rendering into a canvas
+static uint32_t canvasBytes = 0;
+
+static bool printFormatted(St7735Matrix &ref, const GFXfont *gfxFont, int16_t x, int16_t y,
+                           int16_t w, int16_t align, String content, uint8_t baseLine,
+                           uint8_t yAdvance = 0) {
+    int16_t xx = 0, yy = 0;
+    uint16_t ww = 0, hh = 0;
+    ref.setTextWrap(false);
+    ref.getTextBounds(content, 0, 0, &xx, &yy, &ww, &hh);
+    switch (align) {
+    default:
+    case 0:
+        xx = 0;
+        break;
+    case 1:
+        xx = (w - ww) / 2;
+        break;
+    case 2:
+        xx = w - ww;
+        break;
+    }
+    if (yAdvance && (hh % yAdvance)) {
+        hh = ((hh / yAdvance) + 1) * yAdvance;
+    }
+    GFXcanvas16 tmp(w, hh);
+    canvasBytes = max(canvasBytes, (uint32_t)w * hh * 2);
+    if (gfxFont) {
+        tmp.setFont(gfxFont);
+    }
+    tmp.fillScreen(ref.getTextBackground());
+    tmp.setTextWrap(false);
+    tmp.setCursor(xx, baseLine ? baseLine : -1 * yy);
+    tmp.setTextColor(ref.getTextColor(), ref.getTextBackground());
+    tmp.print(content);
+    ref.drawRGBBitmap(x, y, tmp.getBuffer(), w, hh);
+    ref.setCursor(x + tmp.getCursorX(), y + (baseLine ? baseLine : -1 * yy));
+    return w >= (int16_t)ww;
+}
+
+static void report(const char *scenario, const St7735Emulator &emu, unsigned long calls,
+                   uint32_t memory) {
+    const St7735Emulator::Stats &stats = emu.getStats();
+    double n = calls ? calls : 1;
+    printf("%-28s %9.1f %7.2f %8.2f %9.1f %9.1f %7u\n", scenario, stats.bytes / n,
+           stats.frames / n, stats.windows / n, stats.pixels / n,
+           emu.getBusTime(clockHz, frameOverhead) / n, memory);
+}
+
+static void printHeader(const char *title) {
+    printf("%s, %.1f MHz SPI clock, %.1f us per frame\n\n", title, clockHz / 1000000.0,
+           frameOverhead);
+    printf("%-28s %9s %7s %8s %9s %9s %7s\n", "scenario (per call)", "bytes", "frames",
+           "windows", "pixels", "bus us", "memory");
+    printf("%-28s %9s %7s %8s %9s %9s %7s\n", "----------------------------", "---------",
+           "-------", "--------", "---------", "---------", "-------");
+}
+
+static bool verifyPixels(const char *scenario, int16_t width, int16_t height,
+                         const St7735Emulator &emu, const St7735Emulator &refEmu) {
+    for (int16_t y = 0; y < height; y++) {
+        for (int16_t x = 0; x < width; x++) {
+            if (emu.getPixel(x, y) != refEmu.getPixel(x, y)) {
+                printf("FAIL: %s: pixel %d,%d differs\n", scenario, x, y);
+                failures++;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void verify(const char *scenario, St7735Matrix &display, const St7735Emulator &emu,
+                   St7735Matrix &ref, const St7735Emulator &refEmu) {
+    if (!verifyPixels(scenario, display.width(), display.height(), emu, refEmu)) {
+        return;
+    }
+    if (display.getCursorX() != ref.getCursorX() || display.getCursorY() != ref.getCursorY()) {
+        printf("FAIL: %s: cursor differs\n", scenario);
+        failures++;
+    }
+}
+
+/*! A text output case of the formatted print benchmark */
+typedef struct {
+    const char *name;
+    const GFXfont *font;
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t align;
+    const char *content;
+    uint8_t baseLine;
+    uint8_t yAdvance;
+} TextCase;
+
+static void benchText() {
+    St7735Emulator emu(csPin, dcPin), refEmu(refCsPin, refDcPin);
+    St7735Matrix display(csPin, dcPin, -1, INITR_BLACKTAB, 1);
+    St7735Matrix ref(refCsPin, refDcPin, -1, INITR_BLACKTAB, 1);
+    display.begin();
+    ref.begin();
+
+    static const TextCase cases[] = {
+        {"classic, full line", nullptr, 0, 0, 160, 0, "Temperature 23.5 C", 0, 8},
+        {"classic, centered", nullptr, 20, 40, 120, 1, "Hello World", 0, 8},
+        {"small font, right", &smallFont, 0, 60, 160, 2, "1013.2 hPa", 7, 8},
+        {"large font, full line", &largeFont, 0, 80, 160, 0, "23.5 C  45 %", 14, 16},
+        {"large font, overflow", &largeFont, 10, 100, 100, 2, "1234567890", 14, 16},
+        {"large font, centered long", &largeFont, 0, 20, 160, 1, "mupplet-display", 14, 16},
+        {"clipped left/bottom", &largeFont, -20, 120, 120, 0, "Clipped", 14, 16},
+        {"clipped right", nullptr, 140, 10, 60, 0, "right edge", 0, 8},
+        {"two lines", &smallFont, 30, 30, 80, 0, "line one\nline two", 7, 8},
+    };
+
+    printHeader("St7735Matrix::printFormatted, 160x128");
+    for (const TextCase &tc : cases) {
+        display.setFont(tc.font);
+        ref.setFont(tc.font);
+        display.setTextColor(ST77XX_YELLOW, ST77XX_BLUE);
+        ref.setTextColor(ST77XX_YELLOW, ST77XX_BLUE);
+
+        canvasBytes = 0;
+        refEmu.resetStats();
+        bool refRet = printFormatted(ref, tc.font, tc.x, tc.y, tc.w, tc.align, tc.content,
+                                     tc.baseLine, tc.yAdvance);
+        emu.resetStats();
+        bool ret = display.printFormatted(tc.x, tc.y, tc.w, tc.align, tc.content, tc.baseLine,
+                                          tc.yAdvance);
+        if (ret != refRet) {
+            printf("FAIL: %s: return value differs\n", tc.name);
+            failures++;
+        }
+        verify(tc.name, display, emu, ref, refEmu);
+
+        char szBuffer[40];
+        snprintf(szBuffer, sizeof(szBuffer), "%s", tc.name);
+        report(szBuffer, emu, 1,
+               St7735Matrix::lineBufferSize * 2 + sizeof(St7735ClassicGlyphs));
+        snprintf(szBuffer, sizeof(szBuffer), "  canvas");
+        report(szBuffer, refEmu, 1, canvasBytes);
+    }
+    printf("\n");
+}
+
+static void drawDashboard(St7735Matrix &display, int second) {
+    // a typical sensor dashboard updated once per second
+    char szBuffer[32];
+    display.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
+    display.setFont(&largeFont);
+    snprintf(szBuffer, sizeof(szBuffer), "%d.%d C", 20 + (second / 7) % 5, second % 10);
+    display.printFormatted(0, 20, 160, 2, szBuffer, 14, 16);
+    display.setFont(&smallFont);
+    snprintf(szBuffer, sizeof(szBuffer), "12:34:%02d", second % 60);
+    display.printFormatted(0, 0, 80, 0, szBuffer, 7, 8);
+    display.printFormatted(80, 0, 80, 2, "WiFi ok", 7, 8);
+    display.fillRect(10, 60, 140, 8, ST77XX_BLUE);
+    display.fillRect(10, 60, (second * 7) % 141, 8, ST77XX_GREEN);
+    display.drawPixel(80 + second % 60, 100 - (second * 13) % 20, ST77XX_RED);
+}
+
+static void drawPrimitives(St7735Matrix &display) {
+    // all drawing primitives the frame buffer has to intercept
+    static uint16_t image[12 * 10];
+    for (uint16_t i = 0; i < 12 * 10; i++) {
+        image[i] = display.color565(i * 2, 255 - i * 2, i);
+    }
+    display.fillScreen(ST77XX_BLACK);
+    display.drawLine(0, 0, 159, 127, ST77XX_WHITE);
+    display.drawRect(-5, 10, 40, 30, ST77XX_RED);
+    display.fillRect(150, 120, -20, -15, ST77XX_CYAN);
+    display.drawFastHLine(-10, 50, 300, ST77XX_YELLOW);
+    display.drawFastVLine(100, -10, 200, ST77XX_MAGENTA);
+    display.drawLine(120, 20, 140, 60, ST77XX_GREEN);
+    display.drawLine(10, 120, 70, 80, ST77XX_ORANGE);
+    display.drawRGBBitmap(150, 70, image, 12, 10);
+    display.drawRGBBitmap(60, 60, image, 12, 10);
+    display.setFont(nullptr);
+    display.setTextColor(ST77XX_WHITE, ST77XX_BLUE);
+    display.setCursor(5, 110);
+    display.print("direct print");
+}
+
+static void benchFrameBuffer() {
+    St7735Emulator emu(csPin, dcPin), refEmu(refCsPin, refDcPin);
+    St7735Matrix display(csPin, dcPin, -1, INITR_BLACKTAB, 1);
+    St7735Matrix ref(refCsPin, refDcPin, -1, INITR_BLACKTAB, 1);
+    display.begin();
+    ref.begin();
+    if (!display.setBuffered(true)) {
+        printf("FAIL: frame buffer allocation\n");
+        failures++;
+        return;
+    }
+    uint32_t memory = (uint32_t)display.width() * display.height() * 2;
+
+    printHeader("St7735Matrix frame buffer, 160x128");
+    drawPrimitives(display);
+    drawPrimitives(ref);
+    emu.resetStats();
+    display.write();
+    verify("primitives", display, emu, ref, refEmu);
+    report("primitives, first write", emu, 1, memory);
+
+    // the first update transmits the whole dashboard
+    drawDashboard(display, 0);
+    drawDashboard(ref, 0);
+    display.write();
+    verify("dashboard", display, emu, ref, refEmu);
+
+    static const int updates = 120;
+    unsigned long rects = 0;
+    emu.resetStats();
+    refEmu.resetStats();
+    for (int second = 1; second <= updates; second++) {
+        drawDashboard(display, second);
+        drawDashboard(ref, second);
+        rects += display.getDirtyCount();
+        display.write();
+        if (display.getDirtyCount()) {
+            printf("FAIL: dashboard: dirty rectangles left after write\n");
+            failures++;
+        }
+        verify("dashboard", display, emu, ref, refEmu);
+    }
+    report("dashboard, dirty rects", emu, updates, memory);
+    report("  direct", refEmu, updates,
+           St7735Matrix::lineBufferSize * 2 + sizeof(St7735ClassicGlyphs));
+    printf("\n%.2f dirty rectangles per update\n", (double)rects / updates);
+
+    // rewriting unchanged content transmits nothing
+    emu.resetStats();
+    display.setFont(&smallFont);
+    display.printFormatted(80, 0, 80, 2, "WiFi ok", 7, 8);
+    display.fillRect(10, 60, (updates * 7) % 141, 8, ST77XX_GREEN);
+    display.write();
+    if (emu.getStats().bytes) {
+        printf("FAIL: dashboard: unchanged content transmitted\n");
+        failures++;
+    }
+
+    // rotation invalidates the buffer
+    display.setRotation(1);
+    if (display.getDirtyCount() != 1) {
+        printf("FAIL: rotation does not invalidate the frame buffer\n");
+        failures++;
+    }
+    printf("\n");
+}
+
+static void drawPanel(Adafruit_GFX &canvas, const uint16_t *theme) {
+    // a sensor panel like the one drawn by GfxPanel: theme colors 0: text, 1: background,
+    // 2: separator, 3: accent, 4: increase, 5: constant, 6: decrease
+    canvas.fillScreen(theme[1]);
+    canvas.setTextWrap(false);
+    for (int16_t y = 0; y < 128; y += 32) {
+        canvas.drawFastHLine(0, y, 160, theme[2]);
+    }
+    canvas.drawFastVLine(80, 0, 64, theme[2]);
+    canvas.setFont(nullptr);
+    canvas.setTextColor(theme[3]);
+    canvas.setCursor(2, 2);
+    canvas.print("Out C");
+    canvas.setCursor(82, 2);
+    canvas.print("Studio C");
+    canvas.setFont(&largeFont);
+    canvas.setTextColor(theme[0]);
+    canvas.setCursor(4, 28);
+    canvas.print("12.5");
+    canvas.setCursor(84, 28);
+    canvas.print("21.0");
+    for (int16_t x = 0; x < 160; x++) {
+        int16_t y0 = 100 + ((x * 7) % 23) - 11, y1 = 100 + (((x + 1) * 7) % 23) - 11;
+        canvas.drawLine(x, y0, x + 1, y1, y1 < y0 ? theme[4] : y1 > y0 ? theme[6] : theme[5]);
+    }
+}
+
+static void benchIndexedCanvas() {
+    static const uint16_t darkTheme[] = {0xFFFF, 0x0000, 0x8410, 0xB596, 0xFC10, 0xC618, 0x841F};
+    static const uint16_t dimTheme[] = {0x7BEF, 0x0000, 0x4208, 0x5ACB, 0x7A08, 0x630C, 0x420F};
+    St7735Emulator emu(csPin, dcPin), refEmu(refCsPin, refDcPin);
+    Adafruit_ST7735 display(csPin, dcPin, -1), ref(refCsPin, refDcPin, -1);
+    display.initR(INITR_BLACKTAB);
+    ref.initR(INITR_BLACKTAB);
+    display.setRotation(1);
+    ref.setRotation(1);
+
+    GFXcanvas16 refCanvas(160, 128);
+    drawPanel(refCanvas, darkTheme);
+    refEmu.resetStats();
+    ref.drawRGBBitmap(0, 0, refCanvas.getBuffer(), 160, 128);
+
+    printHeader("IndexedCanvas, 160x128");
+    report("RGB565 canvas", refEmu, 1, 160 * 128 * 2);
+    for (uint8_t bits = 4; bits <= 8; bits += 4) {
+        char szBuffer[40];
+        IndexedCanvas canvas(160, 128, bits);
+        uint32_t memory = 160 * 128 * bits / 8 + canvas.getPaletteSize() * 2;
+        for (uint8_t i = 0; i < 7; i++) {
+            canvas.addColor(darkTheme[i]);
+        }
+        drawPanel(canvas, darkTheme);
+        emu.resetStats();
+        canvas.drawTo(&display);
+        snprintf(szBuffer, sizeof(szBuffer), "%d bpp canvas", bits);
+        report(szBuffer, emu, 1, memory);
+        verifyPixels(szBuffer, 160, 128, emu, refEmu);
+        if (canvas.getColorCount() != 7) {
+            printf("FAIL: %s: %d colors registered instead of 7\n", szBuffer,
+                   canvas.getColorCount());
+            failures++;
+        }
+
+        // brightness change: rewrite palette instead of redrawing
+        for (uint8_t i = 0; i < 7; i++) {
+            canvas.setPaletteColor(i, dimTheme[i]);
+        }
+        canvas.drawTo(&display);
+        drawPanel(refCanvas, dimTheme);
+        ref.drawRGBBitmap(0, 0, refCanvas.getBuffer(), 160, 128);
+        snprintf(szBuffer, sizeof(szBuffer), "%d bpp palette rewrite", bits);
+        verifyPixels(szBuffer, 160, 128, emu, refEmu);
+        drawPanel(refCanvas, darkTheme);
+        ref.drawRGBBitmap(0, 0, refCanvas.getBuffer(), 160, 128);
+    }
+
+    // a full palette falls back to the nearest color
+    IndexedCanvas canvas(16, 4, 4);
+    for (uint16_t i = 0; i < 20; i++) {
+        canvas.drawPixel(i % 16, i / 16, i << 11);
+    }
+    if (canvas.getColorCount() != 16 || canvas.getPixel(0, 1) != 15 << 11 ||
+        canvas.getPixel(3, 1) != 15 << 11) {
+        printf("FAIL: palette overflow\n");
+        failures++;
+    }
+    printf("\n");
+}
+
+static bool verifyScreen(const char *scenario, int16_t y, int16_t h, const St7735Emulator &emu,
+                         const St7735Emulator &refEmu) {
+    // compares the displayed scroll area with the unscrolled reference
+    for (int16_t row = y; row < y + h; row++) {
+        for (int16_t x = 0; x < 128; x++) {
+            if (emu.getScreenPixel(x, row) != refEmu.getPixel(x, row)) {
+                printf("FAIL: %s: pixel %d,%d differs\n", scenario, x, row);
+                failures++;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void drawLog(St7735Matrix &ref, int16_t y, int16_t h, int16_t lineHeight, int16_t lines,
+                    int16_t pos) {
+    // software scrolling: redraws the visible part of the log with the area scrolled by `pos`
+    char szBuffer[24];
+    int16_t blank = h - pos;
+    if (blank > 0) {
+        ref.fillRect(0, y, 128, blank, ST77XX_BLUE);
+    }
+    for (int16_t line = 0; line < lines; line++) {
+        int16_t top = h + line * lineHeight - pos;
+        int16_t first = top < 0 ? -top : 0;
+        int16_t last = top + lineHeight > h ? h - top : lineHeight;
+        if (first < last) {
+            snprintf(szBuffer, sizeof(szBuffer), "log line %d", line);
+            ref.printFormattedRows(0, y + top + first, 128, 0, szBuffer, 7, 8, first,
+                                   last - first);
+        }
+    }
+}
+
+static void benchScroll() {
+    static const int16_t areaY = 40, areaH = 96, lineHeight = 8, lines = 20;
+    char szBuffer[40];
+    printHeader("St7735Matrix hardware scrolling, 128x160");
+    for (uint8_t rot = 0; rot <= 2; rot += 2) {
+        St7735Emulator emu(csPin, dcPin), refEmu(refCsPin, refDcPin);
+        St7735Matrix display(csPin, dcPin, -1, INITR_BLACKTAB, rot);
+        St7735Matrix ref(refCsPin, refDcPin, -1, INITR_BLACKTAB, rot);
+        display.begin();
+        ref.begin();
+        display.setFont(&smallFont);
+        ref.setFont(&smallFont);
+        display.setTextColor(ST77XX_YELLOW, ST77XX_BLUE);
+        ref.setTextColor(ST77XX_YELLOW, ST77XX_BLUE);
+        snprintf(szBuffer, sizeof(szBuffer), "rotation %d", rot);
+        if (!display.setScrollArea(areaY, areaH)) {
+            printf("FAIL: %s: hardware scrolling not available\n", szBuffer);
+            failures++;
+            continue;
+        }
+        display.fillRect(0, areaY, 128, areaH, ST77XX_BLUE);
+
+        // log lines scroll in row by row like the scroll program items
+        emu.resetStats();
+        refEmu.resetStats();
+        int16_t pos = 0;
+        for (int16_t line = 0; line < lines; line++) {
+            char szLine[24];
+            snprintf(szLine, sizeof(szLine), "log line %d", line);
+            for (int16_t row = 0; row < lineHeight; row++) {
+                display.scrollTo(++pos);
+                display.printFormattedRows(0, display.getScrollRow(pos + areaH - 1), 128, 0,
+                                           szLine, 7, 8, row, 1);
+                drawLog(ref, areaY, areaH, lineHeight, line + 1, pos);
+                if (!verifyScreen(szBuffer, areaY, areaH, emu, refEmu)) {
+                    line = lines;
+                    break;
+                }
+            }
+        }
+        snprintf(szBuffer, sizeof(szBuffer), "rotation %d, scroll step", rot);
+        report(szBuffer, emu, pos, 64);
+        report("  software scrolling", refEmu, pos, 64);
+
+        display.endScroll();
+        if (display.isScrolling() || emu.getScrollStart() != 0) {
+            printf("FAIL: rotation %d: scrolling not ended\n", rot);
+            failures++;
+        }
+    }
+
+    // the controller scrolls along the long side of the panel only
+    St7735Matrix landscape(csPin, dcPin, -1, INITR_BLACKTAB, 1);
+    landscape.begin();
+    if (landscape.setScrollArea(0, 64)) {
+        printf("FAIL: hardware scrolling in landscape orientation\n");
+        failures++;
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (!strcmp(argv[i], "--clock")) {
+            clockHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--overhead")) {
+            frameOverhead = atof(argv[++i]);
+        }
+    }
+    initBenchFont(smallFont, 1);
+    initBenchFont(largeFont, 2);
+    benchText();
+    benchFrameBuffer();
+    benchIndexedCanvas();
+    benchScroll();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+// st7735_emulator.h - byte counting emulator of a ST7735/ST7789 TFT controller
+
+#pragma once
+
+#include "Arduino.h"
+
+namespace host {
+
+/*! \brief Emulator of a ST77xx TFT controller
+ *
+ * The emulator listens to GPIO writes on the configured chip select and data/command pins and to
+ * all SPI transfers performed while the chip select line is low. Bytes sent while the data/command
+ * line is low are commands, all other bytes are parameters of the last command.
+ *
+ * The emulated display RAM contains one RGB565 value per pixel. Column and row address set,
+ * memory write, memory data access control (row/column exchange and mirroring) and the vertical
+ * scrolling commands (including leaving the scroll mode by normal display mode on) are
+ * implemented, all other commands are only counted. Besides the display RAM, the emulator counts
+ * the transferred bytes, the commands, the address windows and the written pixels, which allows
+ * to estimate the time the SPI bus has been busy.
+ */
+class St7735Emulator : public Device {
+  public:
+    /*! The statistic counters of the emulated controller */
+    typedef struct {
+        unsigned long bytes;     ///< Bytes transferred
+        unsigned long frames;    ///< Chip select frames
+        unsigned long commands;  ///< Commands received
+        unsigned long windows;   ///< Memory write commands (address windows)
+        unsigned long pixels;    ///< Pixels written to the display RAM
+    } Stats;
+
+  protected:
+    uint8_t csPin;
+    uint8_t dcPin;
+    uint16_t ramWidth;
+    uint16_t ramHeight;
+    bool selected;
+    bool data;
+    uint8_t command;
+    uint8_t params[8];
+    uint8_t paramCount;
+    uint16_t xs, xe, ys, ye, cx, cy;
+    uint8_t madctl;
+    uint16_t tfa, vsa, bfa, ssa;
+    bool displayOn;
+    uint16_t *ram;
+    Stats stats;
+
+  public:
+    /*! Instantiate a ST77xx emulator
+     * @param csPin     The chip select pin the controller is connected to
+     * @param dcPin     The data/command pin the controller is connected to
+     * @param ramWidth  Number of columns of the display RAM (default: 128)
+     * @param ramHeight Number of rows of the display RAM (default: 160)
+     */
+    St7735Emulator(uint8_t csPin, uint8_t dcPin, uint16_t ramWidth = 128, uint16_t ramHeight = 160)
+        : csPin(csPin), dcPin(dcPin), ramWidth(ramWidth), ramHeight(ramHeight), selected(false),
+          data(true), command(0), paramCount(0), xs(0), xe(ramWidth - 1), ys(0),
+          ye(ramHeight - 1), cx(0), cy(0), madctl(0), tfa(0), vsa(ramHeight), bfa(0), ssa(0),
+          displayOn(false) {
+        ram = (uint16_t *)calloc((size_t)ramWidth * ramHeight, sizeof(uint16_t));
+        resetStats();
+    }
+
+    virtual ~St7735Emulator() {
+        free(ram);
+    }
+
+    /*! Reset the statistic counters */
+    void resetStats() {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    /*! Get the statistic counters
+     * @return The statistic counters accumulated since the last call to `resetStats()`
+     */
+    const Stats &getStats() const {
+        return stats;
+    }
+
+    /*! Get a pixel from the display RAM
+     *
+     * The coordinates are interpreted like the column and row addresses of a memory write with
+     * the current memory data access control setting.
+     *
+     * @param x     Column address
+     * @param y     Row address
+     * @return      The RGB565 value of the pixel
+     */
+    uint16_t getPixel(uint16_t x, uint16_t y) const {
+        uint16_t col, row;
+        if (!physical(x, y, col, row)) {
+            return 0;
+        }
+        return ram[row * ramWidth + col];
+    }
+
+    /*! Get a pixel as shown on the screen
+     *
+     * Like \ref getPixel() but takes the vertical scrolling into account: the result is the
+     * pixel displayed at the position where a memory write to the specified address would appear
+     * without scrolling.
+     *
+     * @param x     Column address
+     * @param y     Row address
+     * @return      The RGB565 value of the displayed pixel
+     */
+    uint16_t getScreenPixel(uint16_t x, uint16_t y) const {
+        uint16_t col, row;
+        if (!physical(x, y, col, row)) {
+            return 0;
+        }
+        if (row >= tfa && row < tfa + vsa && vsa) {
+            row = tfa + (row - tfa + ssa - tfa) % vsa;
+        }
+        return ram[row * ramWidth + col];
+    }
+
+    /*! Get the current vertical scroll start address */
+    uint16_t getScrollStart() const {
+        return ssa;
+    }
+
+    /*! Check if the display is turned on */
+    bool isDisplayOn() const {
+        return displayOn;
+    }
+
+    /*! Estimate the time the SPI bus has been busy
+     * @param clockHz       SPI clock frequency in Hz
+     * @param frameOverhead Additional time in microseconds consumed by each chip select frame
+     * @return              Estimated bus time in microseconds
+     */
+    double getBusTime(double clockHz, double frameOverhead) const {
+        return (double)stats.bytes * 8.0 * 1000000.0 / clockHz +
+               (double)stats.frames * frameOverhead;
+    }
+
+    virtual void onPinWrite(uint8_t pin, uint8_t value) {
+        if (pin == csPin) {
+            if (value == LOW) {
+                selected = true;
+            } else if (selected) {
+                selected = false;
+                stats.frames++;
+            }
+        } else if (pin == dcPin) {
+            data = value != LOW;
+        }
+    }
+
+    virtual void onSpiTransfer(uint8_t value) {
+        if (!selected) {
+            return;
+        }
+        stats.bytes++;
+        if (!data) {
+            stats.commands++;
+            command = value;
+            paramCount = 0;
+            if (command == 0x2C) {
+                // RAMWR
+                stats.windows++;
+                cx = xs;
+                cy = ys;
+            } else if (command == 0x28 || command == 0x29) {
+                // DISPOFF, DISPON
+                displayOn = command == 0x29;
+            } else if (command == 0x13) {
+                // NORON leaves the vertical scrolling mode
+                tfa = 0;
+                vsa = ramHeight;
+                bfa = 0;
+                ssa = 0;
+            }
+            return;
+        }
+        if (command == 0x2C) {
+            params[paramCount++] = value;
+            if (paramCount == 2) {
+                writePixel((params[0] << 8) | params[1]);
+                paramCount = 0;
+            }
+            return;
+        }
+        if (paramCount < sizeof(params)) {
+            params[paramCount++] = value;
+        }
+        switch (command) {
+        case 0x2A:  // CASET
+            if (paramCount == 4) {
+                xs = (params[0] << 8) | params[1];
+                xe = (params[2] << 8) | params[3];
+            }
+            break;
+        case 0x2B:  // RASET
+            if (paramCount == 4) {
+                ys = (params[0] << 8) | params[1];
+                ye = (params[2] << 8) | params[3];
+            }
+            break;
+        case 0x36:  // MADCTL
+            madctl = params[0];
+            break;
+        case 0x33:  // VSCRDEF
+            if (paramCount == 6) {
+                tfa = (params[0] << 8) | params[1];
+                vsa = (params[2] << 8) | params[3];
+                bfa = (params[4] << 8) | params[5];
+            }
+            break;
+        case 0x37:  // VSCRSADD
+            if (paramCount == 2) {
+                ssa = (params[0] << 8) | params[1];
+            }
+            break;
+        }
+    }
+
+  protected:
+    bool physical(uint16_t x, uint16_t y, uint16_t &col, uint16_t &row) const {
+        // MV exchanges column and row addresses, MX and MY mirror them
+        bool mv = madctl & 0x20;
+        uint16_t cols = mv ? ramHeight : ramWidth;
+        uint16_t rows = mv ? ramWidth : ramHeight;
+        if (x >= cols || y >= rows) {
+            return false;
+        }
+        if (madctl & 0x40) {
+            x = cols - 1 - x;
+        }
+        if (madctl & 0x80) {
+            y = rows - 1 - y;
+        }
+        col = mv ? y : x;
+        row = mv ? x : y;
+        return true;
+    }
+
+    void writePixel(uint16_t color) {
+        uint16_t col, row;
+        stats.pixels++;
+        if (physical(cx, cy, col, row)) {
+            ram[row * ramWidth + col] = color;
+        }
+        if (++cx > xe) {
+            cx = xs;
+            if (++cy > ye) {
+                cy = ys;
+            }
+        }
+    }
+};
+
+}  // namespace host
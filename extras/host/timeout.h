@@ -0,0 +1,32 @@
+// timeout.h - host replacement of the ustd timeout class
+
+#pragma once
+
+#include "Arduino.h"
+
+namespace ustd {
+
+class timeout {
+  protected:
+    unsigned long timebase;
+    unsigned long value;
+
+  public:
+    timeout(unsigned long value = 0) : timebase(millis()), value(value) {
+    }
+    timeout &operator=(unsigned long newValue) {
+        value = newValue;
+        return *this;
+    }
+    operator unsigned long() const {
+        return value;
+    }
+    bool test() const {
+        return millis() - timebase >= value;
+    }
+    void reset() {
+        timebase = millis();
+    }
+};
+
+}  // namespace ustd
@@ -0,0 +1,52 @@
+// ustd_array.h - host replacement of the ustd dynamic array
+//
+// Provides the subset of `ustd::array` used by the display mupplets on top of `std::vector`.
+
+#pragma once
+
+#include <vector>
+
+#define ARRAY_INC_SIZE 16
+#define ARRAY_MAX_SIZE 65535
+#define ARRAY_INIT_SIZE 16
+
+namespace ustd {
+
+template <typename T> class array {
+  protected:
+    std::vector<T> items;
+
+  public:
+    array(unsigned int startSize = ARRAY_INIT_SIZE, unsigned int maxSize = ARRAY_MAX_SIZE,
+          unsigned int incSize = ARRAY_INC_SIZE, bool shrink = true) {
+        items.reserve(startSize);
+    }
+    int add(T item) {
+        items.push_back(item);
+        return (int)items.size() - 1;
+    }
+    bool erase(unsigned int index) {
+        if (index >= items.size()) {
+            return false;
+        }
+        items.erase(items.begin() + index);
+        return true;
+    }
+    void erase() {
+        items.clear();
+    }
+    unsigned int length() const {
+        return (unsigned int)items.size();
+    }
+    bool isEmpty() const {
+        return items.empty();
+    }
+    T &operator[](unsigned int index) {
+        return items[index];
+    }
+    const T &operator[](unsigned int index) const {
+        return items[index];
+    }
+};
+
+}  // namespace ustd
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+# Use this script to generate the 14 and 16 segment font tables
+# in src/hardware/segment_fonts.h
+#
+# 14 segment layout (bit 0 = A ... bit 13 = N, bit 14 = DP):
+#
+#    -----A-----
+#   |\    |    /|
+#   F H   J   K B
+#   |  \  |  /  |
+#    -G1-   -G2-
+#   |  /  |  \  |
+#   E L   M   N C
+#   |/    |    \|
+#    -----D-----  DP
+#
+# 16 segment layout (bit 0 = A1 ... bit 15 = M, no DP):
+#
+#    --A1-- --A2--
+#   |\     |     /|
+#   F H    I    J B
+#   |  \   |   /  |
+#    --G1-- --G2--
+#   |  /   |   \  |
+#   E K    L    M C
+#   |/     |     \|
+#    --D1-- --D2--
+
+# 16 segment layout of the HT1622 10 digit glass. Every digit occupies two SEG lines with 8 COM
+# lines each (4 display RAM nibbles, bit 0 = COM0 of the left SEG line ... bit 15 = COM7 of the
+# right SEG line). The decimal dots are located in a separate raw digit.
+#
+#   left SEG:  COM0 A1, COM1 H, COM2 F, COM3 G1, COM4 E, COM5 K, COM6 D1, COM7 I
+#   right SEG: COM0 A2, COM1 J, COM2 B, COM3 G2, COM4 C, COM5 M, COM6 D2, COM7 L
+
+seg14 = ["A", "B", "C", "D", "E", "F", "G1", "G2", "H", "J", "K", "L", "M", "N", "DP"]
+glass16 = ["A1", "H", "F", "G1", "E", "K", "D1", "I", "A2", "J", "B", "G2", "C", "M", "D2", "L"]
+seg16 = ["A1", "A2", "B", "C", "D1", "D2", "E", "F", "G1", "G2", "H", "I", "J", "K", "L", "M"]
+
+# 14 segment name -> 16 segment names
+to16 = {"A": "A1 A2", "B": "B", "C": "C", "D": "D1 D2", "E": "E", "F": "F", "G1": "G1",
+        "G2": "G2", "H": "H", "J": "I", "K": "J", "L": "K", "M": "L", "N": "M", "DP": ""}
+
+glyphs = [
+    "", "B C DP", "B J", "B C D G1 G2 J M",  # 0x20   ! " #
+    "A C D F G1 G2 J M", "C F K L", "A D E G1 H J N", "J",  # 0x24 $ % & '
+    "K N", "H L", "G1 G2 H J K L M N", "G1 G2 J M",  # 0x28 ( ) * +
+    "L", "G1 G2", "DP", "K L",  # 0x2C , - . /
+    "A B C D E F K L", "B C K", "A B D E G1 G2", "A B C D G2",  # 0x30 0 1 2 3
+    "B C F G1 G2", "A D F G1 N", "A C D E F G1 G2", "A B C",  # 0x34 4 5 6 7
+    "A B C D E F G1 G2", "A B C D F G1 G2", "J M", "J L",  # 0x38 8 9 : ;
+    "K N", "D G1 G2", "H L", "A B G2 M DP",  # 0x3C < = > ?
+    "A B D E F G2 J", "A B C E F G1 G2", "A B C D G2 J M", "A D E F",  # 0x40 @ A B C
+    "A B C D J M", "A D E F G1", "A E F G1", "A C D E F G2",  # 0x44 D E F G
+    "B C E F G1 G2", "A D J M", "B C D E", "E F G1 K N",  # 0x48 H I J K
+    "D E F", "B C E F H K", "B C E F H N", "A B C D E F",  # 0x4C L M N O
+    "A B E F G1 G2", "A B C D E F N", "A B E F G1 G2 N", "A C D F G1 G2",  # 0x50 P Q R S
+    "A J M", "B C D E F", "E F K L", "B C E F L N",  # 0x54 T U V W
+    "H K L N", "H K M", "A D K L", "A D E F",  # 0x58 X Y Z [
+    "H N", "A B C D", "L N", "D",  # 0x5C \ ] ^ _
+    "H", "D E G1 M", "D E F G1 N", "D E G1 G2",  # 0x60 ` a b c
+    "B C D G2 L", "D E G1 L", "A E F G1", "B C D G2 K",  # 0x64 d e f g
+    "C E F G1 G2", "M", "E J L", "J K M N",  # 0x68 h i j k
+    "E F", "C E G1 G2 M", "C E G1 G2", "C D E G1 G2",  # 0x6C l m n o
+    "A B E F G1 G2", "A B C F G1 G2", "E G1", "D G2 N",  # 0x70 p q r s
+    "D E F G1", "C D E", "E L", "C E L N",  # 0x74 t u v w
+    "H K L N", "B C D G2 J", "D G1 L", "A D G1 J M",  # 0x78 x y z {
+    "J M", "A D G2 J M", "G1 G2 J", "",  # 0x7C | } ~
+]
+
+# 16 segment glyphs that differ from the converted 14 segment glyphs (no DP available)
+overrides16 = {"!": "I", ".": "D1"}
+
+
+def encode(names, segments):
+    code = 0
+    for name in names.split():
+        code |= 1 << segments.index(name)
+    return code
+
+
+def convert(names):
+    return " ".join(to16[name] for name in names.split())
+
+
+def table(name, codes):
+    print("static const uint16_t %s[] PROGMEM = {" % name)
+    for row in range(0, 96, 8):
+        line = ", ".join("0x%04X" % code for code in codes[row:row + 8])
+        print("    %s%s  // 0x%02X" % (line, "," if row < 88 else "", row + 0x20))
+    print("};")
+    print()
+
+
+codes14 = [encode(glyph, seg14) for glyph in glyphs]
+codes16 = [encode(overrides16.get(chr(index + 0x20), convert(glyph)), seg16)
+           for index, glyph in enumerate(glyphs)]
+
+table("max72xxFont14Seg", codes14)
+table("max72xxFont16Seg", codes16)
+table("ht1622Font16Seg", [encode(overrides16.get(chr(index + 0x20), convert(glyph)), glass16)
+                          for index, glyph in enumerate(glyphs)])
@@ -0,0 +1,268 @@
+// display_digits_ht162x.h - mupplet for 7 and 16 segment LCD digits using HT1621 or HT1622
+
+#pragma once
+
+#include "muwerk.h"
+#include "helper/light_controller.h"
+#include "helper/mup_display.h"
+#include "hardware/ht162x_digits.h"
+
+namespace ustd {
+
+class DisplayDigitsHT162X : public MuppletDisplay {
+  public:
+    static const char *version;  // = "0.1.0";
+
+  private:
+    // hardware configuration
+    Ht162xDigits display;
+    uint8_t blPin;
+    bool blActiveLogic = false;
+    uint8_t blChannel;
+    uint16_t blPwmRange;
+
+    // runtime
+    LightController light;
+
+  public:
+    /*! Instantiates a DisplayDigitsHT162X mupplet
+     *
+     * No hardware interaction is performed, until \ref begin() is called.
+     *
+     * @param name          Name of the display, used to reference it by pub/sub messages
+     * @param lcdType       The type of the LCD glass: `Ht162xDigits::lcd12digit_7segment` (HT1621)
+     *                      or `Ht162xDigits::lcd10digit_16segment` (HT1622)
+     * @param csPin         The chip select pin #
+     * @param wrPin         The write clock pin #
+     * @param dataPin       The data pin #
+     * @param blPin         The back light pin # (optional, pass -1 if no backlight control)
+     * @param blActiveLogic Characterizes the physical logic-level which would turn the backlight
+     *                      on. Default is 'false', which assumes the led turns on if logic level
+     *                      at the GPIO port is LOW. Change to 'true', if led is turned on by
+     *                      physical logic level HIGH.
+     * @param blChannel     Currently ESP32 only, can be ignored for all other platforms.
+     *                      ESP32 requires assignment of a system-wide unique channel number
+     *                      (0..15) for each led in the system. So for ESP32 both the GPIO port
+     *                      number and a unique channel id are required.
+     */
+    DisplayDigitsHT162X(String name, Ht162xDigits::LcdType lcdType, uint8_t csPin, uint8_t wrPin,
+                        uint8_t dataPin, uint8_t blPin = -1, bool blActiveLogic = false,
+                        uint8_t blChannel = 0)
+        : MuppletDisplay(name, 0), display(lcdType, csPin, wrPin, dataPin), blPin(blPin),
+          blActiveLogic(blActiveLogic), blChannel(blChannel) {
+    }
+
+    /*! Initialize the display hardware and start operation
+     *
+     * If a backlight pin is configured, the light controller drives the backlight and the LCD
+     * stays always on. Without backlight the light state switches the LCD on and off.
+     *
+     * @param _pSched       Pointer to a muwerk scheduler object, used to create worker
+     *                      tasks and for message pub/sub.
+     * @param initialState  Initial logical state of the display: false=off, true=on.
+     */
+    void begin(Scheduler *_pSched, bool initialState = false) {
+        pSched = _pSched;
+        tID = pSched->add([this]() { this->loop(); }, name, 80000L);
+
+        pSched->subscribe(tID, name + "/display/#", [this](String topic, String msg, String orig) {
+            if (topic.length() > name.length() + 8) {
+                this->commandParser(topic.c_str() + name.length() + 9, msg);
+            }
+        });
+        pSched->subscribe(tID, name + "/light/#", [this](String topic, String msg, String orig) {
+            this->light.commandParser(topic.substring(name.length() + 7), msg);
+        });
+
+        // initialize default values
+        current_font = 0;
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        programInit();
+#endif
+        // prepare hardware
+        if (hasBacklight()) {
+            initBacklightHardware();
+        }
+        display.begin();
+        display.setTextWrap(false);
+
+        // start light controller
+        light.begin([this](bool state, double level, bool control,
+                           bool notify) { this->onLightControl(state, level, control, notify); },
+                    initialState);
+    }
+
+  private:
+    void loop() {
+        light.loop();
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        programLoop();
+#endif
+    }
+
+    void onLightControl(bool state, double level, bool control, bool notify) {
+        if (control) {
+            if (!hasBacklight()) {
+                // no backlight - switch the LCD itself
+                display.setPowerSave(!state);
+            } else if (state && level == 1.0) {
+                // backlight is on at maximum brightness
+#ifdef __ESP32__
+                ledcWrite(blChannel, blActiveLogic ? blPwmRange : 0);
+#else
+                digitalWrite(blPin, blActiveLogic ? HIGH : LOW);
+#endif
+            } else if (state && level > 0.0) {
+                // backlight is dimmed
+                uint16_t bri = (uint16_t)(level * (double)blPwmRange);
+                if (bri) {
+                    if (!blActiveLogic) {
+                        bri = blPwmRange - bri;
+                    }
+#ifdef __ESP32__
+                    ledcWrite(blChannel, bri);
+#else
+                    analogWrite(blPin, bri);
+#endif
+                } else {
+                    light.forceState(false, 0.0);
+                    onLightControl(false, 0.0, control, notify);
+                }
+            } else {
+                // backlight is off
+#ifdef __ESP32__
+                ledcWrite(blChannel, blActiveLogic ? 0 : blPwmRange);
+#else
+                digitalWrite(blPin, blActiveLogic ? LOW : HIGH);
+#endif
+            }
+        }
+        if (notify) {
+            pSched->publish(name + "/light/unitbrightness", String(level, 3));
+            pSched->publish(name + "/light/state", state ? "on" : "off");
+        }
+    }
+
+    // abstract methods implementation
+    virtual void getDimensions(int16_t &width, int16_t &height) {
+        width = display.width();
+        height = display.height();
+    }
+
+    virtual bool getTextWrap() {
+        return display.getTextWrap();
+    }
+
+    virtual void setTextWrap(bool wrap) {
+        display.setTextWrap(wrap);
+    }
+
+    virtual FontSize getTextFontSize() {
+        FontSize retVal;
+        retVal.baseLine = 0;
+        retVal.xAdvance = 1;
+        retVal.yAdvance = 1;
+        return retVal;
+    }
+
+    virtual uint8_t getTextFontCount() {
+        return 1;
+    }
+
+    virtual void setTextFont(uint8_t font, int16_t baseLineAdjustment) {
+    }
+
+    virtual void setTextColor(uint16_t fg, uint16_t bg) {
+    }
+
+    virtual void getCursor(int16_t &x, int16_t &y) {
+        x = display.getCursorX();
+        y = display.getCursorY();
+    }
+
+    virtual void setCursor(int16_t x, int16_t y) {
+        display.setCursor(x, y);
+    }
+
+    virtual void displayClear(int16_t x, int16_t y, int16_t w, int16_t h) {
+        display.fillRect(x, y, w, h);
+        display.write();
+    }
+
+    virtual void displayClear(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t bg) {
+        display.fillRect(x, y, w, h);
+        display.write();
+    }
+
+    virtual void displayPrint(String content, bool ln = false) {
+        if (ln) {
+            display.println(content);
+        } else {
+            display.print(content);
+        }
+        display.write();
+    }
+
+    virtual bool displayFormat(int16_t x, int16_t y, int16_t w, int16_t align, String content,
+                               uint8_t font, uint16_t color, uint16_t bg) {
+        bool ret = display.printFormatted(x, y, w, align, content);
+        display.write();
+        return ret;
+    }
+
+    virtual bool displayNumber(int16_t x, int16_t y, int16_t w, int32_t value, uint8_t decimals) {
+        bool ret = display.printNumber(x, y, w, value, decimals);
+        display.write();
+        return ret;
+    }
+
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    virtual bool initNextCharDimensions(ProgramItem &item) {
+        while (charPos < item.content.length()) {
+            charX = display.getCharLen(item.content[charPos], false);
+            charY = 1;
+            if (charX) {
+                if (item.content[charPos] == ' ') {
+                    lastPos += charX;
+                } else {
+                    return true;
+                }
+            } else if (item.content[charPos] == ' ') {
+                lastPos += charX;
+            }
+            // char is not printable
+            ++charPos;
+        }
+        // end of string
+        return false;
+    }
+#endif
+
+    // implementation
+    inline bool hasBacklight() const {
+        return blPin != (uint8_t)-1 && blPin != 0;
+    }
+
+    void initBacklightHardware() {
+#if defined(__ESP32__)
+        pinMode(blPin, OUTPUT);
+// use first channel of 16 channels (started from zero)
+#define LEDC_TIMER_BITS 10
+// use 5000 Hz as a LEDC base frequency
+#define LEDC_BASE_FREQ 5000
+        ledcSetup(blChannel, LEDC_BASE_FREQ, LEDC_TIMER_BITS);
+        ledcAttachPin(blPin, blChannel);
+#else
+        pinMode(blPin, OUTPUT);
+#endif
+#ifdef __ESP__
+        blPwmRange = 1023;
+#else
+        blPwmRange = 255;
+#endif
+    }
+};
+
+const char *DisplayDigitsHT162X::version = "0.1.0";
+
+}  // namespace ustd
@@ -29,24 +29,29 @@ class DisplayDigitsMAX72XX : public MuppletDisplay {
      * @param csPin     The chip select pin.
      * @param hDisplays Horizontal number of display units. (default: 1)
      * @param vDisplays Vertical number of display units. (default: 1)
-     * @param length    Number of digits per unit (default: 8)
+     * @param length    Number of digits per unit (default: 8, max. 4 for 14 and 16 segment digits)
+     * @param segments  Number of segments per digit: 7, 14 or 16 (default: 7)
      */
     DisplayDigitsMAX72XX(String name, uint8_t csPin, uint8_t hDisplays = 1, uint8_t vDisplays = 1,
-                         uint8_t length = 8)
-        : MuppletDisplay(name, 0), display(csPin, hDisplays, vDisplays, length) {
+                         uint8_t length = 8, uint8_t segments = 7)
+        : MuppletDisplay(name, 0), display(csPin, hDisplays, vDisplays, length, segments) {
     }
 
     /*! Initialize the display hardware and start operation
      * @param _pSched       Pointer to a muwerk scheduler object, used to create worker
      *                      tasks and for message pub/sub.
      * @param initialState  Initial logical state of the display: false=off, true=on.
+     * @param asyncWrite    If `true` the display output does not block the scheduler. The frame
+     *                      buffer is transmitted one digit per scheduler tick.
      */
-    void begin(Scheduler *_pSched, bool initialState = false) {
+    void begin(Scheduler *_pSched, bool initialState = false, bool asyncWrite = false) {
         pSched = _pSched;
         tID = pSched->add([this]() { this->loop(); }, name, 80000L);
 
         pSched->subscribe(tID, name + "/display/#", [this](String topic, String msg, String orig) {
-            this->commandParser(topic.substring(name.length() + 9), msg, name + "/display");
+            if (topic.length() > name.length() + 8) {
+                this->commandParser(topic.c_str() + name.length() + 9, msg);
+            }
         });
         pSched->subscribe(tID, name + "/light/#", [this](String topic, String msg, String orig) {
             this->light.commandParser(topic.substring(name.length() + 7), msg);
@@ -60,6 +65,9 @@ class DisplayDigitsMAX72XX : public MuppletDisplay {
         // prepare hardware
         display.begin();
         display.setTextWrap(false);
+        if (asyncWrite && display.setAsync(true)) {
+            pSched->add([this]() { this->display.writeStep(); }, name + "/write", 1000L);
+        }
 
         // start light controller
         light.begin([this](bool state, double level, bool control,
@@ -155,6 +163,16 @@ class DisplayDigitsMAX72XX : public MuppletDisplay {
         return ret;
     }
 
+    virtual bool displayNumber(int16_t x, int16_t y, int16_t w, int32_t value, uint8_t decimals) {
+        bool ret = display.printNumber(x, y, w, value, decimals);
+        display.write();
+        return ret;
+    }
+
+    virtual bool displayReady() {
+        return display.isWriteComplete();
+    }
+
 #ifdef USTD_FEATURE_PROGRAMPLAYER
     virtual bool initNextCharDimensions(ProgramItem &item) {
         while (charPos < item.content.length()) {
@@ -48,6 +48,9 @@ class DisplayMatrixMAX72XX : public MuppletGfxDisplay {
 
     // runtime
     LightController light;
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    Max72xxStrip *pMarquee;
+#endif
 
   public:
     /*! Instantiates a DisplayMatrixMAX72XX mupplet
@@ -67,19 +70,54 @@ class DisplayMatrixMAX72XX : public MuppletGfxDisplay {
                          uint8_t rotation = 0)
         : MuppletGfxDisplay(name, MUPDISP_FEATURE_MONO),
           display(csPin, hDisplays, vDisplays, rotation) {
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        pMarquee = nullptr;
+#endif
+    }
+
+    /*! Instantiates a DisplayMatrixMAX72XX mupplet spread over multiple chains
+     *
+     * Large displays can be split into multiple chains of modules, each one connected to its own
+     * chip select pin and optionally to its own SPI bus. See \ref Max72xxMatrix for details.
+     *
+     * No hardware interaction is performed, until \ref begin() is called.
+     *
+     * @param name      Name of the display, used to reference it by pub/sub messages
+     * @param chains    Number of chains.
+     * @param csPins    Array of `chains` chip select pins.
+     * @param hDisplays Horizontal number of 8x8 display units.
+     * @param vDisplays Vertical number of 8x8 display units.
+     * @param rotation  Define if and how the displays are rotated. (default: 0)
+     * @param pSPIs     Optional array of `chains` SPI busses the chains are connected to. If not
+     *                  specified, all chains are connected to the default `SPI` bus.
+     */
+    DisplayMatrixMAX72XX(String name, uint8_t chains, const uint8_t *csPins, uint8_t hDisplays,
+                         uint8_t vDisplays, uint8_t rotation = 0, SPIClass **pSPIs = nullptr)
+        : MuppletGfxDisplay(name, MUPDISP_FEATURE_MONO),
+          display(chains, csPins, hDisplays, vDisplays, rotation, pSPIs) {
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        pMarquee = nullptr;
+#endif
     }
 
     /*! Initialize the display hardware and start operation
      * @param _pSched       Pointer to a muwerk scheduler object, used to create worker
      *                      tasks and for message pub/sub.
      * @param initialState  Initial logical state of the display: false=off, true=on.
+     * @param asyncWrite    If `true` the display output does not block the scheduler. The frame
+     *                      buffer is transmitted one row per scheduler tick.
      */
-    void begin(Scheduler *_pSched, bool initialState = false) {
+    void begin(Scheduler *_pSched, bool initialState = false, bool asyncWrite = false) {
         pSched = _pSched;
         tID = pSched->add([this]() { this->loop(); }, name, 10000L);
 
         pSched->subscribe(tID, name + "/display/#", [this](String topic, String msg, String orig) {
-            this->commandParser(topic.substring(name.length() + 9), msg, name + "/display");
+            // all output caused by a command is flushed as one frame
+            this->display.beginFrame();
+            if (topic.length() > name.length() + 8) {
+                this->commandParser(topic.c_str() + name.length() + 9, msg);
+            }
+            this->display.endFrame();
         });
         pSched->subscribe(tID, name + "/light/#", [this](String topic, String msg, String orig) {
             this->light.commandParser(topic.substring(name.length() + 7), msg);
@@ -93,6 +131,9 @@ class DisplayMatrixMAX72XX : public MuppletGfxDisplay {
         // prepare hardware
         display.begin();
         display.setTextWrap(false);
+        if (asyncWrite && display.setAsync(true)) {
+            pSched->add([this]() { this->display.writeStep(); }, name + "/write", 1000L);
+        }
 
         // start light controller
         light.begin([this](bool state, double level, bool control,
@@ -100,12 +141,28 @@ class DisplayMatrixMAX72XX : public MuppletGfxDisplay {
                     initialState);
     }
 
+    /*! Set the maximum frame rate of the display
+     *
+     * By default every output operation is flushed immediately to the display. If a frame rate is
+     * set, all output is collected and flushed at a steady cadence. Since the display is served
+     * by the mupplet's worker task every 10 milliseconds, the effective frame rate cannot exceed
+     * 100 frames per second.
+     *
+     * @param fps   Frames per second or 0 in order to flush every output operation immediately
+     */
+    void setFrameRate(uint16_t fps) {
+        display.setFrameRate(fps);
+    }
+
   private:
     void loop() {
         light.loop();
 #ifdef USTD_FEATURE_PROGRAMPLAYER
+        display.beginFrame();
         programLoop();
+        display.endFrame();
 #endif
+        display.frameStep();
     }
 
     void onLightControl(bool state, double level, bool control, bool notify) {
@@ -188,6 +245,79 @@ class DisplayMatrixMAX72XX : public MuppletGfxDisplay {
         return ret;
     }
 
+    virtual bool displayReady() {
+        return display.isWriteComplete();
+    }
+
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    virtual bool initNextCharDimensions(ProgramItem &item) {
+        while (charPos < item.content.length()) {
+            int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+            int16_t x = 0, y = sizes[item.font].baseLine;
+            display.getCharBounds(item.content[charPos], &x, &y, &minx, &miny, &maxx, &maxy);
+            if (maxx >= minx) {
+                charX = x;
+                charY = sizes[item.font].yAdvance;
+                if (item.content[charPos] == ' ') {
+                    lastPos += charX;
+                } else {
+                    return true;
+                }
+            } else if (item.content[charPos] == ' ') {
+                lastPos += charX;
+            }
+            // char is not printable
+            ++charPos;
+        }
+        // end of string
+        return false;
+    }
+
+    virtual bool marqueeBegin(ProgramItem &item) {
+        marqueeEnd();
+        // measure the content
+        int16_t xx = 0, yy = 0;
+        uint16_t ww = 0, hh = 0;
+        bool old_wrap = display.getTextWrap();
+        display.setFont(fonts[item.font]);
+        display.setTextWrap(false);
+        display.getTextBounds(item.content.c_str(), 0, 0, &xx, &yy, &ww, &hh);
+        display.setTextWrap(old_wrap);
+        display.setFont(fonts[current_font]);
+        if (ww == 0) {
+            return false;
+        }
+        // render the content once into the off-screen strip
+        pMarquee = new Max72xxStrip(ww, program_height);
+        if (pMarquee->getBuffer() == nullptr) {
+            marqueeEnd();
+            return false;
+        }
+        pMarquee->setFont(fonts[item.font]);
+        pMarquee->setTextWrap(false);
+        pMarquee->setTextColor(1, 0);
+        pMarquee->setCursor(-xx, sizes[item.font].baseLine ? sizes[item.font].baseLine : -yy);
+        pMarquee->print(item.content.c_str());
+        return true;
+    }
+
+    virtual bool marqueeStep(ProgramItem &item, int16_t pos) {
+        if (pMarquee == nullptr) {
+            return false;
+        }
+        // the content enters on the right side and leaves on the left side
+        display.drawStrip(0, program_pos, program_width, *pMarquee, pos - program_width,
+                          item.color, item.bg);
+        display.write();
+        return pos < program_width + pMarquee->width();
+    }
+
+    virtual void marqueeEnd() {
+        delete pMarquee;
+        pMarquee = nullptr;
+    }
+#endif
+
     // implementation
     void getTextDimensions(uint8_t font, const char *content, int16_t &width, int16_t &height) {
         if (!content || !*content) {
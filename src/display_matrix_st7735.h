@@ -22,6 +22,9 @@ class DisplayMatrixST7735 : public MuppletGfxDisplay {
 
     // runtime
     LightController light;
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    int16_t scrollPos;  // hardware scroll position of the player area
+#endif
 
   public:
     /*! Instantiates a DisplayMatrixST7735 mupplet
@@ -61,13 +64,18 @@ class DisplayMatrixST7735 : public MuppletGfxDisplay {
      * @param _pSched       Pointer to a muwerk scheduler object, used to create worker
      *                      tasks and for message pub/sub.
      * @param initialState  Initial logical state of the display: false=off, true=on.
+     * @param buffered      If `true`, the display is operated with a frame buffer in RAM and only
+     *                      the changed areas are transmitted to the display once per loop. If the
+     *                      frame buffer cannot be allocated, the display is driven directly.
      */
-    void begin(Scheduler *_pSched, bool initialState = false) {
+    void begin(Scheduler *_pSched, bool initialState = false, bool buffered = false) {
         pSched = _pSched;
         tID = pSched->add([this]() { this->loop(); }, name, 10000L);
 
         pSched->subscribe(tID, name + "/display/#", [this](String top, String msg, String org) {
-            this->commandParser(top.substring(name.length() + 9), msg, name + "/display");
+            if (top.length() > name.length() + 8) {
+                this->commandParser(top.c_str() + name.length() + 9, msg);
+            }
         });
         if (blPin != -1 && blPin != 0) {
             // backlight control enabled - initialize hardware
@@ -88,6 +96,10 @@ class DisplayMatrixST7735 : public MuppletGfxDisplay {
         display.begin();
         display.setTextWrap(false);
         display.setTextColor(current_fg, current_bg);
+        if (buffered) {
+            // falls back to direct drawing if the frame buffer cannot be allocated
+            display.setBuffered(true);
+        }
 
         // start light controller
         if (blPin != -1 && blPin != 0) {
@@ -107,6 +119,8 @@ class DisplayMatrixST7735 : public MuppletGfxDisplay {
 #ifdef USTD_FEATURE_PROGRAMPLAYER
         programLoop();
 #endif
+        // transmit the changes of the last loop (if buffered)
+        display.write();
     }
 
     void onLightControl(bool state, double level, bool control, bool notify) {
@@ -234,6 +248,44 @@ class DisplayMatrixST7735 : public MuppletGfxDisplay {
         // end of string
         return false;
     }
+
+    virtual bool scrollBegin(ProgramItem &item) {
+        if (display.isScrolling()) {
+            // continue scrolling the area of the previous scroll item
+            return true;
+        }
+        if (!display.setScrollArea(program_pos, program_height)) {
+            // landscape orientation or unsupported panel
+            return false;
+        }
+        display.fillRect(0, program_pos, program_width, program_height, item.bg);
+        scrollPos = 0;
+        return true;
+    }
+
+    virtual bool scrollStep(ProgramItem &item, int16_t pos) {
+        uint8_t lineHeight = sizes[item.font].yAdvance ? sizes[item.font].yAdvance : 8;
+        if (pos >= lineHeight || !display.isScrolling()) {
+            return false;
+        }
+        // the row scrolled out at the top is exposed at the bottom
+        display.scrollTo(++scrollPos);
+        display.setFont(fonts[item.font]);
+        display.setTextColor(item.color, item.bg);
+        display.printFormattedRows(0, display.getScrollRow(scrollPos + program_height - 1),
+                                   program_width, 0, item.content.c_str(),
+                                   sizes[item.font].baseLine, sizes[item.font].yAdvance, pos, 1);
+        display.setTextColor(current_fg, current_bg);
+        display.setFont(fonts[current_font]);
+        return pos < lineHeight - 1;
+    }
+
+    virtual void scrollEnd() {
+        if (display.isScrolling()) {
+            display.endScroll();
+            displayClear(0, program_pos, program_width, program_height);
+        }
+    }
 #endif
 
     // implementation
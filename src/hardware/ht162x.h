@@ -0,0 +1,127 @@
+// ht162x.h - HT1621/HT1622 driver class
+
+#pragma once
+
+#include <Arduino.h>
+
+namespace ustd {
+/*! \brief The HT162X Controller Class
+ *
+ * This class implements the bit banged 3-wire communication interface (CS, WR and DATA) to a
+ * Holtek HT1621 (32x4) or HT1622 (32x8) RAM mapping LCD controller. The read line is not used.
+ *
+ * Commands are sent as a 3 bit mode ID followed by one or more 9 bit commands. Display RAM is
+ * written in successive address mode: after the mode ID and the 6 bit start address any number of
+ * 4 bit nibbles can be sent and the address is incremented automatically. Address and commands
+ * are sent MSB first, data nibbles LSB first. See the Holtek HT1621 and HT1622 datasheets.
+ */
+class Ht162X {
+  protected:
+    // hardware configuration
+    uint8_t csPin;
+    uint8_t wrPin;
+    uint8_t dataPin;
+
+  public:
+    /*! The HT162x commands (datasheet command summary, 9 bit command codes) */
+    enum CMD {
+        sysdis = 0x00,    ///< Turn off system oscillator and LCD bias generator
+        sysen = 0x02,     ///< Turn on system oscillator
+        lcdoff = 0x04,    ///< Turn off LCD bias generator
+        lcdon = 0x06,     ///< Turn on LCD bias generator
+        wdtdis = 0x0a,    ///< Disable WDT time-out flag output
+        rc = 0x30,        ///< System clock source: on-chip RC oscillator
+        bias4com = 0x52   ///< HT1621 only: 1/3 bias, 4 commons
+    };
+
+    /*! The number of display RAM nibbles of the HT1622 (HT1621: 32) */
+    static const uint8_t maxNibbles = 64;
+
+    /*! The bit clock half period in microseconds. The HT162x needs a WR low and high time of at
+     * least 3.34 us at 3 V (1.67 us at 5 V), so this value is safe for 3.3 V boards. */
+    static const uint8_t clockDelayUs = 4;
+
+    /*! Instantiate a Ht162X instance
+     *
+     * @param csPin     The chip select pin
+     * @param wrPin     The write clock pin
+     * @param dataPin   The data pin
+     */
+    Ht162X(uint8_t csPin, uint8_t wrPin, uint8_t dataPin)
+        : csPin(csPin), wrPin(wrPin), dataPin(dataPin) {
+    }
+
+    /*! Start the driver class
+     */
+    void begin() {
+        pinMode(csPin, OUTPUT);
+        pinMode(wrPin, OUTPUT);
+        pinMode(dataPin, OUTPUT);
+        digitalWrite(csPin, HIGH);
+        digitalWrite(wrPin, HIGH);
+    }
+
+    /*! Sends a sequence of commands in one command mode frame
+     * @param commands  The commands to send
+     * @param count     Number of commands
+     */
+    void sendCommands(const uint16_t *commands, uint8_t count) {
+        digitalWrite(csPin, LOW);
+        sendBits(0b100, 3);
+        while (count--) {
+            sendBits(*commands++, 9);
+        }
+        digitalWrite(csPin, HIGH);
+    }
+
+    /*! Sends a single command
+     * @param command   The command to send
+     */
+    void sendCommand(uint16_t command) {
+        sendCommands(&command, 1);
+    }
+
+    /*! Starts a successive address write to the display RAM
+     *
+     * Send the data with \ref writeNibble() and finish the transfer with \ref endWrite().
+     *
+     * @param address   Address of the first nibble to write (0..63)
+     */
+    void beginWrite(uint8_t address) {
+        digitalWrite(csPin, LOW);
+        sendBits(0b101, 3);
+        sendBits(address, 6);
+    }
+
+    /*! Writes a nibble to the current display RAM address and increments the address
+     * @param data  The 4 bit data to write (bit 0 is sent first)
+     */
+    void writeNibble(uint8_t data) {
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            clockBit(data & (1 << bit));
+        }
+    }
+
+    /*! Finishes a successive address write
+     */
+    inline void endWrite() {
+        digitalWrite(csPin, HIGH);
+    }
+
+  protected:
+    void sendBits(uint16_t data, uint8_t count) {
+        while (count--) {
+            clockBit(data & (1 << count));
+        }
+    }
+
+    inline void clockBit(bool bit) {
+        // data is latched on the rising edge of WR
+        digitalWrite(wrPin, LOW);
+        digitalWrite(dataPin, bit ? HIGH : LOW);
+        delayMicroseconds(clockDelayUs);
+        digitalWrite(wrPin, HIGH);
+        delayMicroseconds(clockDelayUs);
+    }
+};
+}  // namespace ustd
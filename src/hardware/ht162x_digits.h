@@ -2,309 +2,171 @@
 
 #pragma once
 
+#include "ht162x.h"
+#include "segment_fonts.h"
+#include "segment_digits.h"
 
 namespace ustd {
 
-
-
-/* leo stuff:
-static const uint8_t digitTable7Seg[] PROGMEM = {B01111110, B00110000, B01101101, B01111001,
-                                                 B00110011, B01011011, B01011111, B01110000,
-                                                 B01111111, B01111011};
-
-static const uint8_t charTable7Seg[] PROGMEM = {
-    B01110111, B00011111, B00001101, B00111101, B01001111, B01000111, B01011110,
-    B00110111, B00000110, B00111100, B00000111, B00001110, B01110110, B00010101,
-    B00011101, B01100111, B11101110, B00000101, B01011011, B01000110, B00111110,
-    B00011100, B00011100, B01001001, B00100111, B01101101};
-*/
 /*! \brief The HT162X Digits Display Class
  *
- * This class derived from `Print` class provides an implementation of a 7/16 segment digits display.
+ * This class derived from \ref SegmentDigits provides an implementation of a 7 or 16 segment digits
+ * LCD driven by a Holtek HT1621 or HT1622 controller connected over a bit banged 3-wire interface.
+ *
+ * The segments of every raw digit of the glass are mapped to consecutive nibbles of the display
+ * RAM: two nibbles per 7 segment digit (HT1621) and four nibbles per 16 segment digit (HT1622).
+ * The font tables are stored in display RAM layout, so every character costs a single table lookup.
+ * The decimal dots of the 16 segment glass are located in a separate raw digit: bit n of raw digit
+ * 11 is the dot after digit n.
+ * Since bit banging is slow, \ref write() compares the frame buffer with the content sent before
+ * and only transmits the changed nibbles using successive address writes.
  */
-class Ht162xDigits : public Print {
-  private:
-    static const uint8_t digitTable7Seg[]={0b10111110, 0b00000110, 0b01111100, 0b01011110, 0b11000110, 
-                        0b11011010, 0b11111010, 0b00001110, 0b11111110, 0b11011110};
+class Ht162xDigits : public SegmentDigits<Ht162xDigits> {
+    friend class SegmentDigits<Ht162xDigits>;
 
-    static const uint8_t charTable7Seg[]={
-            // A
-            0b11101110, 0b11110010, 0b01110000, 0b01110110, 0b11111000, 0b11101000,
-            // G
-            0b10111010, 0b11100110, 0b00000010, 0b00110110, 0b11100101, 0b10110000,
-            // M
-            0b10101110, 0b01100010, 0b01110010, 0b11101100, 0b11001111, 0b01100000,
-            // S
-            0b11011010, 0b11110000, 0b10110110, 0b00110010, 0b10110111, 0b11100110,
-            //Y
-            0b11100100, 0b01111100 }; 
-    // See command summary, datasheet p.13:
-    //                                   cmd prefix   command      comment
-    //                                          ---   -----------  ------------
-    static const uint8_t cmdBIAS    = 0x52;  // 100 | 0 010a bXcX, ab=10 4 commons option, c=1 1/3 cmdcmdBIAS option 
-    static const uint8_t cmdSYS_DIS = 0X00;  // 100 | 0 0000 000X, Turn off both system oscillator and LCD bias generator
-    static const uint8_t cmdSYS_EN  = 0X02;  // 100 | 0 0000 001X, Turn on system oscillator
-    static const uint8_t cmdLCD_OFF = 0X04;  // 100 | 0 0000 010X, Turn off LCD bias generator
-    static const uint8_t cmdLCD_ON  = 0X06;  // 100 | 0 0000 011X, Turn on LCD bias generator
-    static const uint8_t cmdWDT_DIS = 0X0A;  // 100 | 0 0000 101X, Disable WDT time-out flag output
-    static const uint8_t cmdRC_256K = 0X30;  // 100 | 0 0011 0XXX, System clock source, on-chip RC oscillator
+  public:
+    /*! The supported LCD types */
+    enum LcdType {
+        lcd12digit_7segment,  ///< HT1621 glass with 12 7 segment digits
+        lcd10digit_16segment  ///< HT1622 glass with 10 16 segment digits
+    };
+
+    /*! The maximum number of raw digits of the supported LCD types */
+    static const uint8_t frameBufferSize = 13;
 
-    // device configuration
+  private:
+    // A new burst costs 9 bits (mode ID and address) and a chip select cycle, an unchanged nibble
+    // inside a burst costs 4 bits - so gaps of up to two unchanged nibbles are sent within a burst
+    static const uint8_t maxGap = 2;
+
+    // hardware configuration
+    Ht162X driver;
     LcdType lcdType;
-    uint8_t csPin;
-    uint8_t wrPin;
-    uint8_t dataPin;
-    uint8_t lcdBacklightPin;
-    uint8_t pwmIndexEsp32;
 
-    int digitCnt;
-    int digitRawCnt;
-    int segmentCnt;
+    uint8_t digitCnt;
+    uint8_t digitRawCnt;
+    uint8_t nibblesPerDigit;
+    uint8_t dotDigit;  // raw digit containing the decimal dots (0 = dots are part of the digits)
     bool isActive;
 
-    static const long clearDelayMs = 2;
-    static const long printDelayMs = 2;
-    static const long writeDelayUs = 4;
-
     // runtime - pixel and module logic
-    uint8_t length;
-    uint8_t bitmapSize;
-    uint8_t *bitmap;
-    uint8_t *outputBuffer;
-    int16_t _width;
-    int16_t _height;
-    int16_t cursor_x;
-    int16_t cursor_y;
-    bool wrap;
+    uint16_t bitmap[frameBufferSize];       // segment state of the raw digits
+    uint16_t frameBuffer[frameBufferSize];  // segment state sent to the display RAM
+    bool refresh;
 
   public:
-    enum LcdType {lcd12digit_7segment, lcd10digit_16segment};
-    static const uint8_t frameBufferSize=12; // 12 positions of 8bit used for HT1621, 11 positions of 16bit used for HT1622 
-    uint16_t frameBuffer[frameBufferSize];  // cache for segment state: only rewrite segments on content change
-
-    Ht162xDigits(LcdType lcdType, uint8_t csPin, uint8_t wrPin, uint8_t dataPin, uint8_t lcdBacklightPin=-1, uint8_t pwmIndexEsp32=-1)
-        : name(name), lcdType(lcdType), csPin(csPin), wrPin(wrPin), dataPin(dataPin), lcdBacklightPin(lcdBacklightPin), pwmIndexEsp32(pwmIndexEsp32) {
-    /*! Instantiates a DisplayDigitsHT162x mupplet
+    /*! Instantiate a Ht162xDigits instance
      *
      * No hardware interaction is performed, until \ref begin() is called.
      *
-     * @param name Name of the lcd display, used to reference it by pub/sub messages
-     * @param lcdType \ref LcdType 
+     * @param lcdType   The type of the LCD glass
+     * @param csPin     The chip select pin
+     * @param wrPin     The write clock pin
+     * @param dataPin   The data pin
      */
+    Ht162xDigits(LcdType lcdType, uint8_t csPin, uint8_t wrPin, uint8_t dataPin)
+        : driver(csPin, wrPin, dataPin), lcdType(lcdType) {
         switch (lcdType) {
-            case LcdType::lcd12digit_7segment:
-                digitCnt=12; 
-                digitRawCnt=13;  // Chinese phone-booth title snips at display top
-                segmentCnt=8;
-                isActive=true;
-                break;
-            case LcdType::lcd10digit_16segment:
-                digitCnt=10; 
-                digitRawCnt=12;  // Special case last digits encodes 9 decimal dots  
-                segmentCnt=17;
-                isActive=true;
-                break;
-            default:
-                isActive=false;
-                break;
+        case lcd12digit_7segment:
+            digitCnt = 12;
+            digitRawCnt = 13;  // the last raw digit contains the title segments at the display top
+            nibblesPerDigit = 2;
+            dotDigit = 0;
+            dpMask = seg7ToHt1621(B10000000);
+            font = ht1621Font7Seg[font7SegStandard];
+            wideFont = nullptr;
+            isActive = true;
+            break;
+        case lcd10digit_16segment:
+            digitCnt = 10;
+            digitRawCnt = 12;  // the last raw digits contain the decimal dots
+            nibblesPerDigit = 4;
+            dotDigit = 11;
+            dpMask = 0x10000;  // beyond the segments: set by setChar() in the dot digit
+            font = nullptr;
+            wideFont = ht1622Font16Seg;
+            isActive = true;
+            break;
+        default:
+            digitCnt = 0;
+            digitRawCnt = 0;
+            nibblesPerDigit = 0;
+            dotDigit = 0;
+            dpMask = 0;
+            font = nullptr;
+            wideFont = nullptr;
+            isActive = false;
+            break;
         }
+        memset(bitmap, 0, sizeof(bitmap));
+        memset(frameBuffer, 0, sizeof(frameBuffer));
+        refresh = true;
+        _width = digitCnt;
+        _height = 1;
     }
 
     /*! Start the digits display
+     * @return `true` if the LCD type is supported
      */
-    void begin() {
+    bool begin() {
         if (isActive) {
-            pinMode(csPin, OUTPUT);
-            pinMode(wrPin, OUTPUT);
-            pinMode(dataPin, OUTPUT);
-            if (lcdBacklightPin!=-1) pinMode(lcdBacklightPin, OUTPUT);
-
-            switch (lcdType) {
-                case LcdType::lcd12digit_7segment:
-                    writeCmd(cmdBIAS);     // set LCD bias
-                    writeCmd(cmdRC_256K);  // use internal clock
-                    writeCmd(cmdSYS_DIS);  // disable all generators
-                    writeCmd(cmdWDT_DIS);  // disable watchdog timer output bitj
-                    writeCmd(cmdSYS_EN);   // enable generators
-                    setDisplay(true);       // switch on display
-                    clear();                // Clear display
-                    break;
-                case LcdType::lcd10digit_16segment:
-                    writeCmd(cmdBIAS);     // set LCD bias
-                    writeCmd(cmdRC_256K);  // use internal clock
-                    writeCmd(cmdSYS_DIS);  // disable all generators
-                    writeCmd(cmdWDT_DIS);  // disable watchdog timer output bitj
-                    writeCmd(cmdSYS_EN);   // enable generators
-                    setDisplay(true);       // switch on display
-                    clear();                // Clear display
-                    break;
-                default:
-                    isActive=false;
-                    break;
+            static const uint16_t ht1621Init[] = {Ht162X::bias4com, Ht162X::rc, Ht162X::sysdis,
+                                                  Ht162X::wdtdis, Ht162X::sysen, Ht162X::lcdon};
+            static const uint16_t ht1622Init[] = {Ht162X::rc, Ht162X::sysdis, Ht162X::wdtdis,
+                                                  Ht162X::sysen, Ht162X::lcdon};
+            driver.begin();
+            if (lcdType == lcd12digit_7segment) {
+                driver.sendCommands(ht1621Init, sizeof(ht1621Init) / sizeof(uint16_t));
+            } else {
+                driver.sendCommands(ht1622Init, sizeof(ht1622Init) / sizeof(uint16_t));
             }
+
+            // Clear the display
+            fillScreen(0);
+            invalidate();
+            write();
         }
         return isActive;
     }
 
     /*! Set the power saving mode for the display
-     * @param powersave If `true` the display goes into power-down mode. Set to `false` for normal
-     * operation.
-     */
-    inline void setPowerSave(bool powersave) {
-        driver.setPowerSave(powersave);
-    }
-
-    /*! Set the brightness of the display
-     * @param intensity The brightness of the display. (0..15)
-     */
-    inline void setIntensity(uint8_t intensity) {
-        driver.setIntensity(intensity);
-    }
-
-    /*! Set the test mode for the display
-     * @param testmode  If `true` the display goes into test mode. Set to `false` for normal
-     * operation.
+     * @param powersave If `true` the oscillator and the LCD bias generator are turned off. Set to
+     * `false` for normal operation.
      */
-    inline void setTestMode(bool testmode) {
-        driver.setTestMode(testmode);
-    }
-
-    /*! Set text cursor location
-     * @param x X coordinate in digit positions
-     * @param y Y coordinate in digit positions
-     */
-    void setCursor(int16_t x, int16_t y) {
-        cursor_x = x;
-        cursor_y = y;
-    }
-
-    /*! Set text cursor X location
-     * @param x X coordinate in digit positions
-     */
-    inline void setCursorX(int16_t x) {
-        cursor_x = x;
-    }
-
-    /*! Set text cursor Y location
-     * @param y Y coordinate in digit positions
-     */
-    inline void setCursorY(int16_t y) {
-        cursor_y = y;
-    }
-
-    /*! Set whether text that is too long for the screen width should
-     *      automatically wrap around to the next line (else clip right).
-     * @param w true for wrapping, false for clipping
-     */
-    void setTextWrap(bool w) {
-        wrap = w;
+    void setPowerSave(bool powersave) {
+        if (!isActive) {
+            return;
+        }
+        static const uint16_t powerOff[] = {Ht162X::lcdoff, Ht162X::sysdis};
+        static const uint16_t powerOn[] = {Ht162X::sysen, Ht162X::lcdon};
+        driver.sendCommands(powersave ? powerOff : powerOn, 2);
     }
 
-    /*! Fill a rectangle completely with one pattern.
+    /*! Select the font used for printing text
+     *
+     * The font variant is only applicable to the 7 segment glass.
      *
-     * @param x         Top left corner x coordinate
-     * @param y         Top left corner y coordinate
-     * @param w         Width in digit positions
-     * @param h         Height in digit positions
-     * @param pattern   Pattern to fill the area with
+     * @param variant The font variant used to map characters to segments
      */
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t pattern = B00000000) {
-        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
-        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
-        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
-        h = h < 0 ? 0 : h >= _height - y ? _height - y : h;
-
-        for (int16_t yy = y; yy < y + h; yy++) {
-            memset(bitmap + yy * _width + x, pattern, w);
+    void setFont(Font7Seg variant) {
+        if (font) {
+            font = ht1621Font7Seg[variant == font7SegAlternate ? font7SegAlternate
+                                                               : font7SegStandard];
         }
     }
 
-    /*! Prints a text at a specified location with a specified formatting
+    /*! Set the segments of a raw digit
      *
-     * This method prints a text at the specified location with the specified length using left,
-     * right or centered alignment. All parameters are checked for plasibility and will be adapted
-     * to the current display size.
+     * Raw digits beyond the text digits contain special segments of the glass like title symbols
+     * or decimal dots.
      *
-     * @param x         Top left corner x coordinate
-     * @param y         Top left corner y coordinate
-     * @param w         Width in digit positions
-     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
-     * @param content   The string to print
-     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     * @param index     Index of the raw digit
+     * @param pattern   Segment pattern in display RAM layout (nibble 0 in the lowest bits)
      */
-    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, String content) {
-        uint8_t shadowBuffer[8];
-        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
-        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
-        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
-        memset(bitmap + y * _width + x, B00000000, w);
-        uint8_t *pDst = shadowBuffer;
-        const unsigned char *pSrc = (unsigned char *)content.c_str();
-        while (pDst < shadowBuffer + 8 && *pSrc) {
-            if (*pSrc < 32) {
-                pDst--;
-            } else if (*pSrc == '.' || *pSrc == ',') {
-                if (pDst == shadowBuffer) {
-                    *pDst = B10000000;
-                } else {
-                    pDst--;
-                    *pDst |= B10000000;
-                }
-            } else if (*pSrc == ' ') {
-                *pDst = B00000000;
-            } else if (*pSrc == '-') {
-                *pDst = B00000001;
-            } else if (*pSrc == '_') {
-                *pDst = B00001000;
-            } else if (*pSrc == '=') {
-                *pDst = B00001001;
-            } else if (*pSrc >= '0' && *pSrc <= '9') {
-                *pDst = pgm_read_byte_near(digitTable7Seg + *pSrc - '0');
-            } else if (*pSrc >= 'A' && *pSrc <= 'Z') {
-                *pDst = pgm_read_byte_near(charTable7Seg + *pSrc - 'A');
-            } else if (*pSrc >= 'a' && *pSrc <= 'z') {
-                *pDst = pgm_read_byte_near(charTable7Seg + *pSrc - 'a');
-            } else {
-                *pDst = B00001000;
-            }
-            pSrc++;
-            pDst++;
+    void setRawDigit(uint8_t index, uint16_t pattern) {
+        if (index < digitRawCnt) {
+            bitmap[index] = pattern;
         }
-        int16_t size = pDst - shadowBuffer;
-        int16_t offs = 0;
-        pDst = bitmap + (y * length) + x;  // fist position of the destination slot
-        switch (align) {
-        default:
-        case 0:
-            // left
-            memcpy(pDst, shadowBuffer, min(w, size));
-            break;
-        case 1:
-            // center
-            if (w < size) {
-                // string is larger than slot size - display only middle part
-                offs = (size - w) / 2;
-                memcpy(pDst, shadowBuffer + offs, w);
-            } else {
-                // string is smaller than slot size - display center aligned
-                offs = (w - size) / 2;
-                memcpy(pDst + offs, shadowBuffer, size);
-            }
-            break;
-        case 2:
-            // right
-            if (w < size) {
-                // string is larger than slot size - display only last part
-                offs = size - w;
-                memcpy(pDst, shadowBuffer + offs, w);
-            } else {
-                // string is smaller than slot size - display right aligned
-                offs = w - size;
-                memcpy(pDst + offs, shadowBuffer, size);
-            }
-            break;
-        }
-        return *pSrc == 0 && size <= w;
     }
 
     /*! Flushes the frame buffer to the display
@@ -312,134 +174,94 @@ class Ht162xDigits : public Print {
      * In order to implement flicker free double buffering, no display function has any immediate
      * effect on the display. All display operations are buffered into a frame buffer. By calling
      * this method, the current content of the frame buffer is displayed.
+     *
+     * Only the display RAM nibbles that changed since the last transmission are sent. Changed
+     * nibbles are grouped into successive address writes.
      */
     void write() {
-        if (bitmap != nullptr) {
-            for (uint8_t digit = 0; digit < length; digit++) {
-                uint16_t endOffset = digit;
-                uint16_t startOffset = bitmapSize + endOffset;
-                uint8_t *pPtr = outputBuffer;
-                do {
-                    startOffset -= length;
-                    pPtr[0] = Max72XX::digit0 + length - digit - 1;
-                    pPtr[1] = bitmap[startOffset];
-                    pPtr += 2;
-                } while (startOffset > endOffset);
-                driver.sendBlock(outputBuffer, pPtr - outputBuffer);
+        if (!isActive) {
+            return;
+        }
+        int16_t first = -1;
+        int16_t last = -1;
+        for (uint8_t digit = 0; digit < digitRawCnt; digit++) {
+            if (!refresh && bitmap[digit] == frameBuffer[digit]) {
+                continue;
+            }
+            uint16_t changed = refresh ? 0xffff : bitmap[digit] ^ frameBuffer[digit];
+            for (uint8_t nibble = 0; nibble < nibblesPerDigit; nibble++) {
+                if (!(changed & (0x0f << (nibble * 4)))) {
+                    continue;
+                }
+                int16_t address = digit * nibblesPerDigit + nibble;
+                if (first >= 0 && address - last > maxGap + 1) {
+                    writeBurst(first, last);
+                    first = -1;
+                }
+                if (first < 0) {
+                    first = address;
+                }
+                last = address;
             }
+            frameBuffer[digit] = bitmap[digit];
         }
-    }
-
-    /*! Empty the frame buffer
-     * @param pattern Binary (on or off) pattern to fill with
-     */
-    virtual void fillScreen(uint8_t pattern) {
-        if (bitmap != nullptr) {
-            memset(bitmap, pattern, length * driver.getChainLen());
-            cursor_x = 0;
-            cursor_y = 0;
+        if (first >= 0) {
+            writeBurst(first, last);
         }
+        refresh = false;
     }
 
-    /*! Get width of the display
-     * @returns Width in number of digits
-     */
-    inline int16_t width() const {
-        return _width;
-    };
-
-    /*! Get height of the display
-     * @returns Height in number of rows
-     */
-    inline int16_t height() const {
-        return _height;
-    }
-
-    /*! Returns if too long text will be wrapped to the next line
-     * @returns Wrapping mode
+    /*! Forces the next write to transmit the complete frame buffer
+     *
+     * Use this method if the content of the display RAM may not reflect the last transmitted frame
+     * buffer anymore, e.g. after a power failure of the controller.
      */
-    inline bool getTextWrap() const {
-        return wrap;
+    void invalidate() {
+        refresh = true;
     }
 
-    /*! Get text cursor X location
-     * @returns X coordinate in digit positions
+    /*! Empty the frame buffer
+     * @param pattern Segment pattern to fill with
      */
-    inline int16_t getCursorX() const {
-        return cursor_x;
+    virtual void fillScreen(uint16_t pattern) {
+        for (uint8_t digit = 0; digit < digitCnt; digit++) {
+            setChar(digit, pattern);
+        }
+        cursor_x = 0;
+        cursor_y = 0;
     }
 
-    /*! Get text cursor Y location
-     * @returns Y coordinate in digit positions
-     */
-    inline int16_t getCursorY() const {
-        return cursor_y;
-    };
+  protected:
+    using SegmentDigits<Ht162xDigits>::write;
 
-    /*! Calculates the length in digits of a char
-     * @param c         The ASCII character in question
-     * @param firstChar Set to true, if this is the first chat of a sequence (default: false)
-     */
-    uint8_t getCharLen(unsigned char c, bool firstChar = false) {
-        if (c < 32) {
-            return 0;
-        } else if (c == '.' || c == ',') {
-            return firstChar ? 1 : 0;
+    void writeBurst(uint8_t first, uint8_t last) {
+        driver.beginWrite(first);
+        for (uint8_t address = first; address <= last; address++) {
+            driver.writeNibble(bitmap[address / nibblesPerDigit] >>
+                               ((address % nibblesPerDigit) * 4));
         }
-        return 1;
+        driver.endWrite();
     }
 
-  protected:
-    virtual size_t write(uint8_t c) {
-        if (c == '\r') {
-            cursor_x = 0;
-        } else if (c == '\n') {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        if (wrap && cursor_x >= _width) {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        if (cursor_x >= _width || cursor_y >= _height) {
-            // out of viewport
-            return 1;
-        }
-        if (cursor_x < 0 || cursor_y < 0) {
-            // out of viewport but we must increment when char is prinatble
-            cursor_x += getCharLen(c, cursor_x == 0);
-            return 1;
-        }
-        uint8_t index = cursor_y * _width + cursor_x;
-        if (c < 32) {
-            return 1;
-        } else if (c == '.' || c == ',') {
-            if (cursor_x == 0) {
-                bitmap[index] = B10000000;
+    inline void setChar(uint16_t index, uint32_t code) {
+        bitmap[index] = (uint16_t)code;
+        if (dotDigit && index < digitCnt - 1) {
+            // the glass has no dot after the last digit
+            if (code & dpMask) {
+                bitmap[dotDigit] |= 1 << index;
             } else {
-                bitmap[index - 1] |= B10000000;
-                cursor_x--;
+                bitmap[dotDigit] &= ~(1 << index);
             }
-        } else if (c == ' ') {
-            bitmap[index] = B00000000;
-        } else if (c == '-') {
-            bitmap[index] = B00000001;
-        } else if (c == '_') {
-            bitmap[index] = B00001000;
-        } else if (c == '=') {
-            bitmap[index] = B00001001;
-        } else if (c >= '0' && c <= '9') {
-            bitmap[index] = pgm_read_byte_near(digitTable7Seg + c - '0');
-        } else if (c >= 'A' && c <= 'Z') {
-            bitmap[index] = pgm_read_byte_near(charTable7Seg + c - 'A');
-        } else if (c >= 'a' && c <= 'z') {
-            bitmap[index] = pgm_read_byte_near(charTable7Seg + c - 'a');
-        } else {
-            bitmap[index] = B00001000;
         }
-        cursor_x++;
-        return 1;
     }
+
+    inline void mergeChar(uint16_t index, uint32_t code) {
+        bitmap[index] |= (uint16_t)code;
+        if (dotDigit && index < digitCnt - 1 && (code & dpMask)) {
+            bitmap[dotDigit] |= 1 << index;
+        }
+    }
+
 };
 
-}  // namespace ustd
\ No newline at end of file
+}  // namespace ustd
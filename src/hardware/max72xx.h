@@ -16,6 +16,11 @@ class Max72XX {
     // hardware configuration
     uint8_t csPin;
     uint8_t chainLen;
+    SPIClass *pSPI;
+
+    // runtime
+    uint8_t *frame;
+    uint8_t *registers;
 
   public:
     /*! The maxim 7219/7221 operation modes */
@@ -36,15 +41,27 @@ class Max72XX {
         displaytest = 15  ///< Display Test (0 or 1)
     };
 
+    /*! The maximum number of devices in a chain */
+    static const uint8_t maxChainLen = 16;
+
     /*! Instantiate a Max72XX instance
      *
-     * @param csPin The chip select pin
-     * @param chainLen The length of the device chain
+     * @param csPin     The chip select pin
+     * @param chainLen  The length of the device chain (max. \ref maxChainLen devices)
+     * @param pSPI      The SPI bus the chain is connected to (default: `SPI`)
      * */
-    Max72XX(uint8_t csPin, uint8_t chainLen) : csPin(csPin), chainLen(chainLen) {
-        if (chainLen > 16) {
-            chainLen = 16;
+    Max72XX(uint8_t csPin, uint8_t chainLen, SPIClass *pSPI = &SPI)
+        : csPin(csPin), chainLen(chainLen), pSPI(pSPI) {
+        if (this->chainLen > maxChainLen) {
+            this->chainLen = maxChainLen;
         }
+        frame = (uint8_t *)malloc(this->chainLen * 10);
+        registers = frame != nullptr ? frame + this->chainLen * 2 : nullptr;
+        invalidate();
+    }
+
+    virtual ~Max72XX() {
+        free(frame);
     }
 
     /*! Start the driver class
@@ -55,7 +72,22 @@ class Max72XX {
         digitalWrite(csPin, HIGH);
 
         // multiple init management is done inside the SPI library
-        SPI.begin();
+        pSPI->begin();
+
+        // the register content of the devices is unknown
+        invalidate();
+    }
+
+    /*! Forget the cached configuration register values
+     *
+     * The driver keeps a copy of the configuration registers (decode mode, intensity, scan limit,
+     * shutdown and display test) of every device in order to suppress redundant commands. Call
+     * this method if the devices may have lost their state, e.g. after a power failure.
+     */
+    void invalidate() {
+        if (registers != nullptr) {
+            memset(registers, 0, chainLen * 8);
+        }
     }
 
     /*! Get the number of devices in the chain
@@ -79,6 +111,14 @@ class Max72XX {
         sendCommand(OP::intensity, intensity > 15 ? 15 : intensity);
     }
 
+    /*! Set the brightness of a single device
+     * @param device The index of the device (0 is the device closest to the microcontroller)
+     * @param intensity The brightness of the device. (0..15)
+     */
+    inline void setIntensity(uint8_t device, uint8_t intensity) {
+        sendCommand(device, OP::intensity, intensity > 15 ? 15 : intensity);
+    }
+
     /*! The scan-limit register sets how many digits are displayed, from 1 to 8
      * @param scanLimit Number of digits to show from 1 to 8
      */
@@ -94,6 +134,15 @@ class Max72XX {
         sendCommand(OP::shutdown, powersave ? 0 : 1);
     }
 
+    /*! Set the power saving mode for a single device
+     * @param device The index of the device (0 is the device closest to the microcontroller)
+     * @param powersave If `true` the device goes into power-down mode. Set to `false` for normal
+     * operation.
+     */
+    inline void setPowerSave(uint8_t device, bool powersave) {
+        sendCommand(device, OP::shutdown, powersave ? 0 : 1);
+    }
+
     /*! Set the test mode for all devices
      *
      * In Test mode all leds are turned on in order to check for correct function.
@@ -106,27 +155,133 @@ class Max72XX {
     }
 
     /*! Sends a command to all devices
+     *
+     * Configuration commands are only sent if at least one device does not already have the
+     * requested register value.
      *
      * @param opcode Operation register
      * @param data Operation parameter
      */
     void sendCommand(OP opcode, uint8_t data) {
+        if (opcode >= OP::decodemode && registers != nullptr) {
+            uint8_t device = 0;
+            while (device < chainLen && isCached(device, opcode, data)) {
+                device++;
+            }
+            if (device == chainLen) {
+                // all devices are already configured
+                return;
+            }
+            for (device = 0; device < chainLen; device++) {
+                setCached(device, opcode, data);
+            }
+        }
         digitalWrite(csPin, LOW);
         for (uint8_t count = 0; count < chainLen; count++) {
-            SPI.transfer(opcode);
-            SPI.transfer(data);
+            pSPI->transfer(opcode);
+            pSPI->transfer(data);
         }
         digitalWrite(csPin, HIGH);
     }
 
+    /*! Sends a command to a single device
+     *
+     * All other devices of the chain receive a no-op. Configuration commands are only sent if the
+     * device does not already have the requested register value.
+     *
+     * @param device The index of the device (0 is the device closest to the microcontroller)
+     * @param opcode Operation register
+     * @param data Operation parameter
+     */
+    void sendCommand(uint8_t device, OP opcode, uint8_t data) {
+        if (device >= chainLen || frame == nullptr) {
+            return;
+        }
+        if (opcode >= OP::decodemode) {
+            if (isCached(device, opcode, data)) {
+                return;
+            }
+            setCached(device, opcode, data);
+        }
+        // the first word sent ends up in the last device of the chain
+        memset(frame, 0, chainLen * 2);
+        frame[(chainLen - 1 - device) * 2] = opcode;
+        frame[(chainLen - 1 - device) * 2 + 1] = data;
+        sendBlock(frame, chainLen * 2);
+    }
+
+    /*! Sends a digit register to all devices skipping unchanged devices
+     *
+     * The register value for device `n` (0 is the device closest to the microcontroller) is
+     * located at `data[n * stride]`. `shadow` uses the same layout and contains the values sent by
+     * the previous call. Devices whose value did not change receive a no-op. If no value changed
+     * at all, no frame is sent.
+     *
+     * @param opcode    Digit register (`digit0` to `digit7`)
+     * @param data      Register values to send
+     * @param shadow    Register values sent by the previous call - updated by this call
+     * @param stride    Distance in bytes between the values of two adjacent devices
+     * @param force     If `true` the values are sent to all devices regardless of the shadow
+     * @return          `true` if a frame was sent, `false` if nothing changed
+     */
+    bool sendDigit(uint8_t opcode, const uint8_t *data, uint8_t *shadow, uint8_t stride,
+                   bool force = false) {
+        if (frame == nullptr) {
+            return false;
+        }
+        bool changed = false;
+        uint8_t *pPtr = frame;
+        // the first word sent ends up in the last device of the chain
+        for (uint16_t offset = (chainLen - 1) * stride;; offset -= stride) {
+            if (force || data[offset] != shadow[offset]) {
+                pPtr[0] = opcode;
+                pPtr[1] = data[offset];
+                shadow[offset] = data[offset];
+                changed = true;
+            } else {
+                pPtr[0] = OP::noop;
+                pPtr[1] = 0;
+            }
+            pPtr += 2;
+            if (offset == 0) {
+                break;
+            }
+        }
+        if (changed) {
+            sendBlock(frame, chainLen * 2);
+        }
+        return changed;
+    }
+
     /*! Sends a block of data
      * @param buffer Buffer to send
      * @param size Size in bytes of the buffer to send
      */
-    void sendBlock(uint8_t *buffer, uint8_t size) {
+    void sendBlock(uint8_t *buffer, uint16_t size) {
         digitalWrite(csPin, LOW);
-        SPI.transfer(buffer, size);
+#ifdef __ESP__
+        // write only bulk transfer through the hardware FIFO
+        pSPI->writeBytes(buffer, size);
+#else
+        pSPI->transfer(buffer, size);
+#endif
         digitalWrite(csPin, HIGH);
     }
+
+  protected:
+    // configuration register cache: 7 registers (decodemode to displaytest) and a validity mask
+    // per device
+    inline bool isCached(uint8_t device, uint8_t opcode, uint8_t data) const {
+        const uint8_t *pReg = registers + device * 8;
+        uint8_t index = opcode - OP::decodemode;
+        return (pReg[7] & (1 << index)) && pReg[index] == data;
+    }
+
+    inline void setCached(uint8_t device, uint8_t opcode, uint8_t data) {
+        uint8_t *pReg = registers + device * 8;
+        uint8_t index = opcode - OP::decodemode;
+        pReg[7] |= (1 << index);
+        pReg[index] = data;
+    }
 };
 }  // namespace ustd
\ No newline at end of file
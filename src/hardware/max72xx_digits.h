@@ -3,85 +3,47 @@
 #pragma once
 
 #include "max72xx.h"
+#include "segment_fonts.h"
+#include "segment_digits.h"
 #include "mupplet_core.h"
 
 namespace ustd {
 
-static const uint8_t digitTable7Seg[] PROGMEM = {
-    B01111110,  // 0
-    B00110000,  // 1
-    B01101101,  // 2
-    B01111001,  // 3
-    B00110011,  // 4
-    B01011011,  // 5
-    B01011111,  // 6
-    B01110000,  // 7
-    B01111111,  // 8
-    B01111011   // 9
-};
-
-static const uint8_t charTable7Seg[] PROGMEM = {
-    B01110111,  // A
-    B00011111,  // B
-    B00001101,  // C
-    B00111101,  // D
-    B01001111,  // E
-    B01000111,  // F
-    B01011110,  // G
-    B00110111,  // H
-    B00000110,  // I
-    B00111100,  // J
-    B00000111,  // K
-    B00001110,  // L
-    B01110110,  // M
-    B00010101,  // N
-    B00011101,  // O
-    B01100111,  // P
-    B11101110,  // Q
-    B00000101,  // R
-    B01011011,  // S
-    B00001111,  // T
-    B00111110,  // U
-    B00011100,  // V
-    B00011100,  // W
-    B01001001,  // X
-    B00111011,  // Y
-    B01101101   // Z
-};
-
 #define MAX72XX_DP B10000000
-#define MAX72XX_SPACE B00000000
-#define MAX72XX_EXCLAMATION B10110000
-#define MAX72XX_QUOTES B00100010
-#define MAX72XX_DASH B00000001
-#define MAX72XX_EQUALS B00001001
-#define MAX72XX_UNDERSCORE B00001000
-#define MAX72XX_PAROPEN B01001110
-#define MAX72XX_PARCLOSE B01111000
 
 /*! \brief The MAX72XX Digits Display Class
  *
- * This class derived from `Print` class provides an implementation of a 7 segment digits display
- * based on 8 digits modules driven by a maxim MAX7219 or MAX7221 controller connected over
- * SPI.
+ * This class derived from \ref SegmentDigits provides an implementation of a 7, 14 or 16 segment
+ * digits display based on digits modules driven by a maxim MAX7219 or MAX7221 controller connected
+ * over SPI.
+ *
+ * A 7 segment digit is driven by one digit register of the controller (up to 8 digits per module).
+ * 14 and 16 segment digits are driven by two adjacent digit registers (up to 4 digits per module):
+ * the higher register of the pair holds the segments 0-7, the lower register the segments 8-15.
+ * As with 7 segment digits the rightmost digit uses `digit0`. The segment layouts are
+ * documented in `extras/segment-fonts.py`. 16 segment digits have no decimal point, so dots and
+ * commas occupy a digit position of their own.
  *
  * * See https://datasheets.maximintegrated.com/en/ds/MAX7219-MAX7221.pdf
  */
-class Max72xxDigits : public Print {
+class Max72xxDigits : public SegmentDigits<Max72xxDigits> {
+    friend class SegmentDigits<Max72xxDigits>;
+
   private:
     // hardware configuration
     Max72XX driver;
 
     // runtime - pixel and module logic
     uint8_t length;
+    uint8_t charBytes;
+    uint8_t digits;
     uint8_t bitmapSize;
     uint8_t *bitmap;
-    uint8_t *outputBuffer;
-    int16_t _width;
-    int16_t _height;
-    int16_t cursor_x;
-    int16_t cursor_y;
-    bool wrap;
+    uint8_t *shadow;
+    uint8_t *front;
+    uint8_t pending;
+    bool refresh;
+    unsigned long skippedFrames;
 
   public:
     /*! Instantiate a Max72xxDigits instance
@@ -89,18 +51,46 @@ class Max72xxDigits : public Print {
      * @param csPin     The chip select pin.
      * @param hDisplays Horizontal number of display units. (default: 1)
      * @param vDisplays Vertical number of display units. (default: 1)
-     * @param length    Number of digits per unit (default: 8)
+     * @param length    Number of digits per unit (default: 8, max. 4 for 14 and 16 segment digits)
+     * @param segments  Number of segments per digit: 7, 14 or 16 (default: 7)
      */
-    Max72xxDigits(uint8_t csPin, uint8_t hDisplays = 1, uint8_t vDisplays = 1, uint8_t length = 8)
-        : driver(csPin, hDisplays * vDisplays), length(length > 8 ? 8 : length) {
-        bitmapSize = hDisplays * vDisplays * length;
-        bitmap = (uint8_t *)malloc(bitmapSize + (hDisplays * vDisplays * 2));
-        outputBuffer = bitmap + bitmapSize;
-        _width = hDisplays * length;
+    Max72xxDigits(uint8_t csPin, uint8_t hDisplays = 1, uint8_t vDisplays = 1, uint8_t length = 8,
+                  uint8_t segments = 7)
+        : driver(csPin, hDisplays * vDisplays) {
+        switch (segments) {
+        case 14:
+            charBytes = 2;
+            dpMask = 0x4000;
+            wideFont = max72xxFont14Seg;
+            break;
+        case 16:
+            charBytes = 2;
+            dpMask = 0;
+            wideFont = max72xxFont16Seg;
+            break;
+        default:
+            charBytes = 1;
+            dpMask = MAX72XX_DP;
+            wideFont = nullptr;
+            break;
+        }
+        this->length = length > 8 / charBytes ? 8 / charBytes : length;
+        digits = this->length * charBytes;
+        bitmapSize = hDisplays * vDisplays * digits;
+        bitmap = (uint8_t *)malloc(bitmapSize * 2);
+        shadow = bitmap + bitmapSize;
+        front = nullptr;
+        pending = 0;
+        refresh = true;
+        skippedFrames = 0;
+        _width = hDisplays * this->length;
         _height = vDisplays;
-        cursor_x = 0;
-        cursor_y = 0;
-        wrap = true;
+        font = max72xxFont7Seg[font7SegStandard];
+    }
+
+    virtual ~Max72xxDigits() {
+        free(front);
+        free(bitmap);
     }
 
     /*! Start the digits display
@@ -110,11 +100,12 @@ class Max72xxDigits : public Print {
             // Initialize hardware
             driver.begin();
             driver.setTestMode(false);
-            driver.setScanLimit(length);
+            driver.setScanLimit(digits);
             driver.setDecodeMode(B00000000);
 
             // Clear the display
             fillScreen(0);
+            invalidate();
             write();
         }
     }
@@ -134,6 +125,14 @@ class Max72xxDigits : public Print {
         driver.setIntensity(intensity);
     }
 
+    /*! Set the brightness of a single display unit
+     * @param display   Display index (0 is the first)
+     * @param intensity The brightness of the display unit. (0..15)
+     */
+    inline void setIntensity(uint8_t display, uint8_t intensity) {
+        driver.setIntensity(display, intensity);
+    }
+
     /*! Set the test mode for the display
      * @param testmode  If `true` the display goes into test mode. Set to `false` for normal
      * operation.
@@ -142,293 +141,164 @@ class Max72xxDigits : public Print {
         driver.setTestMode(testmode);
     }
 
-    /*! Set text cursor location
-     * @param x X coordinate in digit positions
-     * @param y Y coordinate in digit positions
-     */
-    void setCursor(int16_t x, int16_t y) {
-        cursor_x = x;
-        cursor_y = y;
-    }
-
-    /*! Set text cursor X location
-     * @param x X coordinate in digit positions
-     */
-    inline void setCursorX(int16_t x) {
-        cursor_x = x;
-    }
-
-    /*! Set text cursor Y location
-     * @param y Y coordinate in digit positions
-     */
-    inline void setCursorY(int16_t y) {
-        cursor_y = y;
-    }
-
-    /*! Set whether text that is too long for the screen width should
-     *      automatically wrap around to the next line (else clip right).
-     * @param w true for wrapping, false for clipping
+    /*! Select the font used for printing text
+     *
+     * The font variant is only applicable to 7 segment digits.
+     *
+     * @param variant The font variant used to map characters to segments
      */
-    void setTextWrap(bool w) {
-        wrap = w;
+    void setFont(Font7Seg variant) {
+        font = max72xxFont7Seg[variant == font7SegAlternate ? font7SegAlternate : font7SegStandard];
     }
 
-    /*! Fill a rectangle completely with one pattern.
+    /*! Flushes the frame buffer to the display
      *
-     * @param x         Top left corner x coordinate
-     * @param y         Top left corner y coordinate
-     * @param w         Width in digit positions
-     * @param h         Height in digit positions
-     * @param pattern   Pattern to fill the area with
+     * In order to implement flicker free double buffering, no display function has any immediate
+     * effect on the display. All display operations are buffered into a frame buffer. By calling
+     * this method, the current content of the frame buffer is displayed.
+     *
+     * Only digit positions that changed since the last transmission are sent. Modules whose digit
+     * did not change receive a no-op and digit positions that did not change on any module are
+     * skipped completely.
+     *
+     * In asynchronous mode the frame buffer is copied into the output buffer and the method
+     * returns immediately. The digits are transmitted by subsequent calls to \ref writeStep().
      */
-    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t pattern = B00000000) {
-        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
-        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
-        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
-        h = h < 0 ? 0 : h >= _height - y ? _height - y : h;
-
-        for (int16_t yy = y; yy < y + h; yy++) {
-            memset(bitmap + yy * _width + x, pattern, w);
+    void write() {
+        if (bitmap == nullptr) {
+            return;
         }
+        if (front != nullptr) {
+            memcpy(front, bitmap, bitmapSize);
+            pending = (1 << digits) - 1;
+            return;
+        }
+        for (uint8_t digit = 0; digit < digits; digit++) {
+            writeDigit(digit, bitmap);
+        }
+        refresh = false;
     }
 
-    /*! Prints a text at a specified location with a specified formatting
+    /*! Enable or disable the asynchronous write mode
      *
-     * This method prints a text at the specified location with the specified length using left,
-     * right or centered alignment. All parameters are checked for plasibility and will be adapted
-     * to the current display size.
+     * In asynchronous mode \ref write() does not block until the whole frame buffer has been
+     * transmitted. Instead the frame is queued in an output buffer and \ref writeStep() must be
+     * called periodically (e.g. by a scheduler task) in order to transmit the queued digits.
      *
-     * @param x         Top left corner x coordinate
-     * @param y         Top left corner y coordinate
-     * @param w         Width in digit positions
-     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
-     * @param content   The string to print
-     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     * @param async `true` to enable asynchronous writes, `false` to write synchronously.
+     * @return      `true` on success, `false` if the output buffer could not be allocated.
      */
-    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, String content) {
-        uint8_t shadowBuffer[8];
-        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
-        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
-        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
-        memset(bitmap + y * _width + x, B00000000, w);
-        uint8_t *pDst = shadowBuffer;
-        const unsigned char *pSrc = (unsigned char *)content.c_str();
-        while (pDst < shadowBuffer + 8 && *pSrc) {
-            if (*pSrc < 32) {
-                pDst--;
-            } else if (*pSrc == '.' || *pSrc == ',') {
-                if (pDst == shadowBuffer) {
-                    *pDst = MAX72XX_DP;
-                } else {
-                    pDst--;
-                    *pDst |= MAX72XX_DP;
-                }
-            } else {
-                *pDst = mapchar(*pSrc);
-            }
-            pSrc++;
-            pDst++;
+    bool setAsync(bool async) {
+        if (bitmap == nullptr) {
+            return false;
         }
-        int16_t size = pDst - shadowBuffer;
-        int16_t offs = 0;
-        int16_t newx = x;
-        pDst = bitmap + (y * length) + x;  // fist position of the destination slot
-        switch (align) {
-        default:
-        case 0:
-            // left
-            memcpy(pDst, shadowBuffer, min(w, size));
-            // set cursor after last printed character
-            newx = x + min(w, size);
-            break;
-        case 1:
-            // center
-            if (w < size) {
-                // string is larger than slot size - display only middle part
-                offs = (size - w) / 2;
-                memcpy(pDst, shadowBuffer + offs, w);
-                newx = x + size - offs;
-            } else {
-                // string is smaller than slot size - display center aligned
-                offs = (w - size) / 2;
-                memcpy(pDst + offs, shadowBuffer, size);
-                newx = x + size + offs;
+        if (async && front == nullptr) {
+            front = (uint8_t *)malloc(bitmapSize);
+            if (front == nullptr) {
+                return false;
             }
-            break;
-        case 2:
-            // right
-            if (w < size) {
-                // string is larger than slot size - display only last part
-                offs = size - w;
-                memcpy(pDst, shadowBuffer + offs, w);
-            } else {
-                // string is smaller than slot size - display right aligned
-                offs = w - size;
-                memcpy(pDst + offs, shadowBuffer, size);
+        } else if (!async && front != nullptr) {
+            // finish the queued frame before switching to synchronous mode
+            while (writeStep()) {
             }
-            newx = x + w;
-            break;
+            free(front);
+            front = nullptr;
         }
-        // set cursor after last printed character
-        setCursor(min(_width, newx), y);
-        return *pSrc == 0 && size <= w;
+        return true;
     }
 
-    /*! Flushes the frame buffer to the display
-     *
-     * In order to implement flicker free double buffering, no display function has any immediate
-     * effect on the display. All display operations are buffered into a frame buffer. By calling
-     * this method, the current content of the frame buffer is displayed.
+    /*! Transmit the next digit of a frame queued by an asynchronous write
+     * @return `true` if more digits are waiting for transmission, `false` if the frame is
+     * complete.
      */
-    void write() {
-        if (bitmap != nullptr) {
-            for (uint8_t digit = 0; digit < length; digit++) {
-                uint16_t endOffset = digit;
-                uint16_t startOffset = bitmapSize + endOffset;
-                uint8_t *pPtr = outputBuffer;
-                do {
-                    startOffset -= length;
-                    pPtr[0] = Max72XX::digit0 + length - digit - 1;
-                    pPtr[1] = bitmap[startOffset];
-                    pPtr += 2;
-                } while (startOffset > endOffset);
-                driver.sendBlock(outputBuffer, pPtr - outputBuffer);
+    bool writeStep() {
+        // unchanged digits do not use up a step
+        uint8_t digit = 0;
+        while (pending) {
+            while (!(pending & (1 << digit))) {
+                digit++;
+            }
+            pending &= ~(1 << digit);
+            if (writeDigit(digit, front)) {
+                break;
             }
         }
-    }
-
-    /*! Empty the frame buffer
-     * @param pattern Binary (on or off) pattern to fill with
-     */
-    virtual void fillScreen(uint8_t pattern) {
-        if (bitmap != nullptr) {
-            memset(bitmap, pattern, length * driver.getChainLen());
-            cursor_x = 0;
-            cursor_y = 0;
+        if (!pending) {
+            refresh = false;
         }
+        return pending != 0;
     }
 
-    /*! Get width of the display
-     * @returns Width in number of digits
-     */
-    inline int16_t width() const {
-        return _width;
-    };
-
-    /*! Get height of the display
-     * @returns Height in number of rows
+    /*! Check if the last frame was transmitted completely
+     * @returns `true` if no digits are waiting for transmission
      */
-    inline int16_t height() const {
-        return _height;
+    inline bool isWriteComplete() const {
+        return pending == 0;
     }
 
-    /*! Returns if too long text will be wrapped to the next line
-     * @returns Wrapping mode
+    /*! Forces the next write to transmit the complete frame buffer
+     *
+     * Use this method if the content of the displays may not reflect the last transmitted frame
+     * buffer anymore, e.g. after a power failure of the modules.
      */
-    inline bool getTextWrap() const {
-        return wrap;
+    void invalidate() {
+        driver.invalidate();
+        refresh = true;
     }
 
-    /*! Get text cursor X location
-     * @returns X coordinate in digit positions
+    /*! Get the number of digit frames that were skipped because no digit changed
+     * @return The number of skipped frames since start or the last call to
+     *         \ref resetSkippedFrames()
      */
-    inline int16_t getCursorX() const {
-        return cursor_x;
+    inline unsigned long getSkippedFrames() const {
+        return skippedFrames;
     }
 
-    /*! Get text cursor Y location
-     * @returns Y coordinate in digit positions
-     */
-    inline int16_t getCursorY() const {
-        return cursor_y;
-    };
+    /*! Reset the counter of skipped digit frames */
+    inline void resetSkippedFrames() {
+        skippedFrames = 0;
+    }
 
-    /*! Calculates the length in digits of a char
-     * @param c         The ASCII character in question
-     * @param firstChar Set to true, if this is the first chat of a sequence (default: false)
+    /*! Empty the frame buffer
+     * @param pattern Segment pattern to fill with
      */
-    uint8_t getCharLen(unsigned char c, bool firstChar = false) {
-        if (c < 32) {
-            return 0;
-        } else if (c == '.' || c == ',') {
-            return firstChar ? 1 : 0;
+    virtual void fillScreen(uint16_t pattern) {
+        if (bitmap != nullptr) {
+            for (uint16_t index = 0; index < _width * _height; index++) {
+                setChar(index, pattern);
+            }
+            cursor_x = 0;
+            cursor_y = 0;
         }
-        return 1;
     }
 
   protected:
-    uint8_t mapchar(uint8_t c) {
-        switch (c) {
-        case '.':
-        case ',':
-            return MAX72XX_DP;
-        case '!':
-            return MAX72XX_EXCLAMATION;
-        case '"':
-            return MAX72XX_QUOTES;
-        case ' ':
-            return MAX72XX_SPACE;
-        case '-':
-            return MAX72XX_DASH;
-        case '=':
-            return MAX72XX_EQUALS;
-        case '(':
-        case '[':
-        case '{':
-            return MAX72XX_PAROPEN;
-        case ')':
-        case ']':
-        case '}':
-            return MAX72XX_PARCLOSE;
-        case '_':
-            return MAX72XX_UNDERSCORE;
-        }
-        if (c >= '0' && c <= '9') {
-            return pgm_read_byte_near(digitTable7Seg + c - '0');
-        } else if (c >= 'A' && c <= 'Z') {
-            return pgm_read_byte_near(charTable7Seg + c - 'A');
-        } else if (c >= 'a' && c <= 'z') {
-            return pgm_read_byte_near(charTable7Seg + c - 'a');
-        } else {
-            return MAX72XX_UNDERSCORE;
+    using SegmentDigits<Max72xxDigits>::write;
+
+    bool writeDigit(uint8_t digit, const uint8_t *source) {
+        // the digit of module n is located at source[n * digits + digit]
+        if (driver.sendDigit(Max72XX::digit0 + digits - digit - 1, source + digit, shadow + digit,
+                             digits, refresh)) {
+            return true;
         }
+        skippedFrames++;
+        return false;
     }
 
-    virtual size_t write(uint8_t c) {
-        if (c == '\r') {
-            cursor_x = 0;
-        } else if (c == '\n') {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        if (wrap && cursor_x >= _width) {
-            cursor_x = 0;
-            cursor_y++;
-        }
-        if (cursor_x >= _width || cursor_y >= _height) {
-            // out of viewport
-            return 1;
+    inline void setChar(uint16_t index, uint32_t code) {
+        uint8_t *pPtr = bitmap + index * charBytes;
+        pPtr[0] = code;
+        if (charBytes > 1) {
+            pPtr[1] = code >> 8;
         }
-        if (cursor_x < 0 || cursor_y < 0) {
-            // out of viewport but we must increment when char is prinatble
-            cursor_x += getCharLen(c, cursor_x == 0);
-            return 1;
-        }
-        uint8_t index = cursor_y * _width + cursor_x;
-        if (c < 32) {
-            return 1;
-        } else if (c == '.' || c == ',') {
-            if (cursor_x == 0) {
-                bitmap[index] = MAX72XX_DP;
-            } else {
-                bitmap[index - 1] |= MAX72XX_DP;
-                cursor_x--;
-            }
-        } else {
-            bitmap[index] = mapchar(c);
+    }
+
+    inline void mergeChar(uint16_t index, uint32_t code) {
+        uint8_t *pPtr = bitmap + index * charBytes;
+        pPtr[0] |= code;
+        if (charBytes > 1) {
+            pPtr[1] |= code >> 8;
         }
-        cursor_x++;
-        return 1;
     }
 };
 
@@ -4,9 +4,35 @@
 
 #include <Adafruit_GFX.h>
 #include "max72xx.h"
+#include "max72xx_strip.h"
 
 namespace ustd {
 
+// position of a pixel inside a module as column (bits 3-5) and row bit (bits 0-2) indexed by
+// module rotation (0-3), module local y and module local x coordinate
+static const uint8_t max72xxPixelMap[4 * 64] PROGMEM = {
+    // rotation 0
+    0x00, 0x08, 0x10, 0x18, 0x20, 0x28, 0x30, 0x38, 0x01, 0x09, 0x11, 0x19, 0x21, 0x29, 0x31, 0x39,
+    0x02, 0x0a, 0x12, 0x1a, 0x22, 0x2a, 0x32, 0x3a, 0x03, 0x0b, 0x13, 0x1b, 0x23, 0x2b, 0x33, 0x3b,
+    0x04, 0x0c, 0x14, 0x1c, 0x24, 0x2c, 0x34, 0x3c, 0x05, 0x0d, 0x15, 0x1d, 0x25, 0x2d, 0x35, 0x3d,
+    0x06, 0x0e, 0x16, 0x1e, 0x26, 0x2e, 0x36, 0x3e, 0x07, 0x0f, 0x17, 0x1f, 0x27, 0x2f, 0x37, 0x3f,
+    // rotation 1
+    0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    // rotation 2
+    0x3f, 0x37, 0x2f, 0x27, 0x1f, 0x17, 0x0f, 0x07, 0x3e, 0x36, 0x2e, 0x26, 0x1e, 0x16, 0x0e, 0x06,
+    0x3d, 0x35, 0x2d, 0x25, 0x1d, 0x15, 0x0d, 0x05, 0x3c, 0x34, 0x2c, 0x24, 0x1c, 0x14, 0x0c, 0x04,
+    0x3b, 0x33, 0x2b, 0x23, 0x1b, 0x13, 0x0b, 0x03, 0x3a, 0x32, 0x2a, 0x22, 0x1a, 0x12, 0x0a, 0x02,
+    0x39, 0x31, 0x29, 0x21, 0x19, 0x11, 0x09, 0x01, 0x38, 0x30, 0x28, 0x20, 0x18, 0x10, 0x08, 0x00,
+    // rotation 3
+    0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00, 0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+    0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10, 0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18,
+    0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x2f, 0x2e, 0x2d, 0x2c, 0x2b, 0x2a, 0x29, 0x28,
+    0x37, 0x36, 0x35, 0x34, 0x33, 0x32, 0x31, 0x30, 0x3f, 0x3e, 0x3d, 0x3c, 0x3b, 0x3a, 0x39, 0x38,
+};
+
 /*! \brief The MAX72XX Matrix Display Class
  *
  * This class derived from Adafruit's core graphics class provides an implementation of a dot matrix
@@ -17,17 +43,63 @@ namespace ustd {
  * * See https://learn.adafruit.com/adafruit-gfx-graphics-library
  */
 class Max72xxMatrix : public Adafruit_GFX {
+  public:
+    /*! The maximum number of 8x8 display units of a display */
+    static const uint8_t maxDisplays = 255;
+
   private:
     // hardware configuration
-    Max72XX driver;
+    Max72XX **drivers;
+    uint8_t chains;
+    uint8_t chainLen;
 
     // runtime - pixel and module logic
     uint8_t hDisplays;
     uint8_t *bitmap;
-    uint8_t bitmapSize;
+    uint16_t bitmapSize;
     uint8_t *matrixPosition;
     uint8_t *matrixRotation;
-    uint8_t *outputBuffer;
+    uint16_t *matrixLayout;
+
+    // runtime - output logic
+    uint8_t *shadow;
+    uint8_t *output;
+    uint8_t *front;
+    uint8_t pending;
+    bool refresh;
+
+    // runtime - clipping
+    bool clipping;
+    int16_t clipX0;
+    int16_t clipY0;
+    int16_t clipX1;
+    int16_t clipY1;
+
+    // runtime - frame pacing
+    uint8_t frameDepth;
+    bool framePending;
+    unsigned long framePeriod;
+    unsigned long frameLast;
+
+    // runtime - grayscale
+    uint8_t grayBits;
+    uint8_t grayPlane;
+    uint8_t grayTicks;
+    uint8_t *planes;
+    uint8_t *grayFront;
+    unsigned long grayLastStep;
+
+  public:
+    /*! The statistic counters of the grayscale mode */
+    typedef struct {
+        unsigned long cycles;        ///< Completed grayscale cycles
+        unsigned long planes;        ///< Bit plane switches
+        unsigned long maxPlaneTime;  ///< Longest time needed to switch a bit plane in microseconds
+        unsigned long maxInterval;   ///< Longest interval between two steps in microseconds
+    } GrayscaleStats;
+
+  private:
+    GrayscaleStats grayStats;
 
   public:
     /*! Instantiate a Max72xxMatrix instance
@@ -41,62 +113,108 @@ class Max72xxMatrix : public Adafruit_GFX {
      *                  degrees and 90 degrees counter clockwise.
      */
     Max72xxMatrix(uint8_t csPin, uint8_t hDisplays = 1, uint8_t vDisplays = 1, uint8_t rotation = 0)
-        : Adafruit_GFX(hDisplays << 3, vDisplays << 3), driver(csPin, hDisplays * vDisplays),
-          hDisplays(hDisplays) {
-        uint8_t displays = hDisplays * vDisplays;
-        bitmapSize = displays * 8;
-        bitmap = (uint8_t *)malloc(bitmapSize + (4 * displays));
-        matrixPosition = bitmap + bitmapSize;
-        matrixRotation = matrixPosition + displays;
-        outputBuffer = matrixRotation + displays;
+        : Adafruit_GFX(hDisplays << 3, vDisplays << 3), hDisplays(hDisplays) {
+        init(1, &csPin, nullptr, rotation);
+    }
 
-        for (uint8_t display = 0; display < displays; display++) {
-            matrixPosition[display] = display;
-            matrixRotation[display] = rotation;
-        }
+    /*! Instantiate a Max72xxMatrix instance spread over multiple chains
+     *
+     * Large displays can be split into multiple chains of modules, each one connected to its own
+     * chip select pin and optionally to its own SPI bus. The displays are distributed in equal
+     * consecutive blocks over the chains: the first chain drives the first displays, the second
+     * chain the following ones and so on. Every chain is flushed independently and chains whose
+     * content did not change are not addressed at all, so the time needed to update the display
+     * depends on the length of the longest chain and not on the total number of modules.
+     *
+     * A display can consist of up to \ref maxDisplays units. A chain can drive up to
+     * \ref Max72XX::maxChainLen units, so at least `ceil(hDisplays * vDisplays / 16)` chains are
+     * needed. Configurations exceeding these limits are rejected and \ref begin() returns `false`.
+     *
+     * @param chains    Number of chains.
+     * @param csPins    Array of `chains` chip select pins.
+     * @param hDisplays Horizontal number of 8x8 display units.
+     * @param vDisplays Vertical number of 8x8 display units.
+     * @param rotation  Define if and how the displays are rotated. (default: 0)
+     * @param pSPIs     Optional array of `chains` SPI busses the chains are connected to. If not
+     *                  specified, all chains are connected to the default `SPI` bus.
+     */
+    Max72xxMatrix(uint8_t chains, const uint8_t *csPins, uint8_t hDisplays, uint8_t vDisplays,
+                  uint8_t rotation = 0, SPIClass **pSPIs = nullptr)
+        : Adafruit_GFX(hDisplays << 3, vDisplays << 3), hDisplays(hDisplays) {
+        init(chains, csPins, pSPIs, rotation);
     }
 
     virtual ~Max72xxMatrix() {
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            delete drivers[chain];
+        }
+        free(drivers);
+        free(planes);
+        free(output);
+        free(front);
         free(bitmap);
     }
 
     /*! Start the matrix display
+     * @return `false` if the frame buffer could not be allocated or the configuration exceeds the
+     *         number of units supported by the display or its chains
      */
-    void begin() {
+    bool begin() {
         if (bitmap != nullptr) {
             // Initialize hardware
-            driver.begin();
-            driver.setTestMode(false);
-            driver.setScanLimit(8);
-            driver.setDecodeMode(B00000000);
+            for (uint8_t chain = 0; chain < chains; chain++) {
+                drivers[chain]->begin();
+                drivers[chain]->setTestMode(false);
+                drivers[chain]->setScanLimit(8);
+                drivers[chain]->setDecodeMode(B00000000);
+            }
 
             // Clear the display
+            updateLayout();
             fillScreen(0);
-            write();
+            invalidate();
+            flush();
         }
+        return bitmap != nullptr;
     }
 
     /*! Set the power saving mode for the display
      * @param powersave If `true` the display goes into power-down mode. Set to `false` for normal
      * operation.
      */
-    inline void setPowerSave(bool powersave) {
-        driver.setPowerSave(powersave);
+    void setPowerSave(bool powersave) {
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            drivers[chain]->setPowerSave(powersave);
+        }
     }
 
     /*! Set the brightness of the display
      * @param intensity The brightness of the display. (0..15)
      */
-    inline void setIntensity(uint8_t intensity) {
-        driver.setIntensity(intensity);
+    void setIntensity(uint8_t intensity) {
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            drivers[chain]->setIntensity(intensity);
+        }
+    }
+
+    /*! Set the brightness of a single display unit
+     * @param display   Display index (0 is the first)
+     * @param intensity The brightness of the display unit. (0..15)
+     */
+    void setIntensity(uint8_t display, uint8_t intensity) {
+        if (chains && display / chainLen < chains) {
+            drivers[display / chainLen]->setIntensity(display % chainLen, intensity);
+        }
     }
 
     /*! Set the test mode for the display
      * @param testmode  If `true` the display goes into test mode. Set to `false` for normal
      * operation.
      */
-    inline void setTestMode(bool testmode) {
-        driver.setTestMode(testmode);
+    void setTestMode(bool testmode) {
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            drivers[chain]->setTestMode(testmode);
+        }
     }
 
     /*! Flushes the frame buffer to the display
@@ -104,22 +222,309 @@ class Max72xxMatrix : public Adafruit_GFX {
      * In order to implement flicker free double buffering, no graphic function has any immediate
      * effect on the display. All graphic operations are buffered into a frame buffer. By calling
      * this method, the current content of the frame buffer is displayed.
+     *
+     * Only the rows that changed since the last flush are transmitted. Modules whose row did not
+     * change receive a no-op. Chains without any changed module are not addressed.
+     *
+     * In asynchronous mode the frame buffer is copied into the output buffer and the method
+     * returns immediately. The rows are transmitted by subsequent calls to \ref writeStep().
+     *
+     * If the frame buffer is kept in logical layout (see \ref setLogicalLayout()) the module
+     * order and rotation is applied here.
+     *
+     * Inside a frame (see \ref beginFrame()) or if a frame rate is set (see
+     * \ref setFrameRate()) the flush is deferred.
      */
     void write() {
-        if (bitmap != nullptr) {
-            for (uint8_t opcode = Max72XX::digit7; opcode >= Max72XX::digit0; opcode--) {
-                uint16_t endOffset = opcode - Max72XX::digit0;
-                uint16_t startOffset = bitmapSize + endOffset;
-                uint8_t *pPtr = outputBuffer;
-                do {
-                    startOffset -= 8;
-                    pPtr[0] = opcode;
-                    pPtr[1] = bitmap[startOffset];
-                    pPtr += 2;
-                } while (startOffset > endOffset);
-                driver.sendBlock(outputBuffer, bitmapSize / 4);
+        if (frameDepth || framePeriod) {
+            // flushed by endFrame() or frameStep()
+            framePending = true;
+            return;
+        }
+        flush();
+    }
+
+    /*! Start a frame
+     *
+     * All calls to \ref write() until the matching call to \ref endFrame() are collected into a
+     * single flush. This allows to compose the content of the display with multiple operations
+     * that would otherwise flush the frame buffer each. Frames can be nested.
+     */
+    inline void beginFrame() {
+        frameDepth++;
+    }
+
+    /*! Complete a frame
+     *
+     * If \ref write() was called since the matching call to \ref beginFrame(), the frame buffer
+     * is flushed now - or by the next due call to \ref frameStep() if a frame rate is set.
+     */
+    void endFrame() {
+        if (frameDepth && !--frameDepth && framePending && !framePeriod) {
+            framePending = false;
+            flush();
+        }
+    }
+
+    /*! Set the maximum frame rate
+     *
+     * If a frame rate is set, \ref write() does not flush the frame buffer immediately. Instead
+     * \ref frameStep() must be called periodically (e.g. by a scheduler task) and flushes the
+     * frame buffer at a steady cadence if it was changed.
+     *
+     * @param fps   Frames per second or 0 in order to flush on every call to \ref write().
+     */
+    void setFrameRate(uint16_t fps) {
+        framePeriod = fps ? 1000000UL / fps : 0;
+        frameLast = micros();
+        if (!framePeriod && framePending && !frameDepth) {
+            framePending = false;
+            flush();
+        }
+    }
+
+    /*! Flush the frame buffer if a new frame is due
+     *
+     * Must be called periodically if a frame rate is set (see \ref setFrameRate()), at least as
+     * often as the frame rate.
+     *
+     * @return `true` if the frame buffer was flushed, `false` otherwise.
+     */
+    bool frameStep() {
+        if (!framePeriod || frameDepth) {
+            return false;
+        }
+        unsigned long now = micros();
+        if (now - frameLast < framePeriod) {
+            return false;
+        }
+        // keep the cadence unless more than a frame was lost
+        frameLast = now - frameLast < 2 * framePeriod ? frameLast + framePeriod : now;
+        if (!framePending) {
+            return false;
+        }
+        framePending = false;
+        flush();
+        return true;
+    }
+
+    /*! Keep the frame buffer in logical layout
+     *
+     * By default the order and rotation of the modules is applied to every single pixel while
+     * drawing. In logical layout the frame buffer is organized like a display consisting only of
+     * unrotated modules in natural order and the module order and rotation is applied once per
+     * module by \ref write(). This reduces the cost of drawing operations on displays with
+     * rotated modules and is advantageous when large parts of the display are redrawn for every
+     * frame (e.g. animations), at the expense of an additional buffer.
+     *
+     * Changing the layout clears the frame buffer.
+     *
+     * @param logical   `true` to keep the frame buffer in logical layout, `false` to apply the
+     *                  module layout while drawing.
+     * @return          `true` on success, `false` if the additional buffer could not be allocated.
+     */
+    bool setLogicalLayout(bool logical) {
+        if (bitmap == nullptr) {
+            return false;
+        }
+        if (logical && output == nullptr) {
+            output = (uint8_t *)malloc(bitmapSize);
+            if (output == nullptr) {
+                return false;
+            }
+        } else if (!logical && output != nullptr) {
+            free(output);
+            output = nullptr;
+        }
+        updateLayout();
+        fillScreen(0);
+        return true;
+    }
+
+    /*! Enable or disable the asynchronous write mode
+     *
+     * In asynchronous mode \ref write() does not block until the whole frame buffer has been
+     * transmitted. Instead the frame is queued in an output buffer and \ref writeStep() must be
+     * called periodically (e.g. by a scheduler task) in order to transmit the queued rows.
+     *
+     * @param async `true` to enable asynchronous writes, `false` to write synchronously.
+     * @return      `true` on success, `false` if the output buffer could not be allocated.
+     */
+    bool setAsync(bool async) {
+        if (bitmap == nullptr) {
+            return false;
+        }
+        if (async && front == nullptr) {
+            if (grayBits) {
+                // not supported in grayscale mode
+                return false;
+            }
+            front = (uint8_t *)malloc(bitmapSize);
+            if (front == nullptr) {
+                return false;
+            }
+        } else if (!async && front != nullptr) {
+            // finish the queued frame before switching to synchronous mode
+            while (writeStep()) {
             }
+            free(front);
+            front = nullptr;
         }
+        return true;
+    }
+
+    /*! Transmit the next changed row of a frame queued by an asynchronous write
+     *
+     * Rows that did not change are skipped, so every call transmits at most one frame to the
+     * devices.
+     *
+     * @return `true` if more rows are waiting for transmission, `false` if the frame is complete.
+     */
+    bool writeStep() {
+        while (pending) {
+            uint8_t offset = 7;
+            while (!(pending & (1 << offset))) {
+                offset--;
+            }
+            pending &= ~(1 << offset);
+            bool sent = sendRow(offset, front);
+            if (!pending) {
+                refresh = false;
+            }
+            if (sent) {
+                break;
+            }
+        }
+        return pending != 0;
+    }
+
+    /*! Check if the last frame was transmitted completely
+     * @returns `true` if no rows are waiting for transmission
+     */
+    inline bool isWriteComplete() const {
+        return pending == 0;
+    }
+
+    /*! Enable or disable the grayscale mode
+     *
+     * The MAX72XX can only switch a led on or off. In grayscale mode every pixel has `bits` bit
+     * planes and the planes are displayed one after the other with binary weighted durations:
+     * the most significant plane is displayed for `2^(bits-1)` steps, the least significant for
+     * one step. \ref grayStep() must be called periodically at a high frequency by a scheduler
+     * task:
+     *
+     * \code{cpp}
+     * matrix.setGrayscale(2);
+     * sched.add([]() { matrix.grayStep(); }, "gray", 2000L);
+     * \endcode
+     *
+     * A full grayscale cycle lasts `2^bits - 1` steps. In order to avoid visible flicker it
+     * should be repeated at least 100 times per second and the transmission of a bit plane must
+     * be shorter than a step. Use \ref getGrayscaleStats() in order to check the frame budget.
+     *
+     * In grayscale mode the drawing colors are gray levels from 0 (off) to `2^bits - 1`
+     * (brightest). The asynchronous write mode is not available and changing the mode clears the
+     * frame buffer.
+     *
+     * @param bits  Number of bit planes (2-4) or 0 to switch back to monochrome mode
+     * @return      `true` on success, `false` if the parameter is not supported or the bit planes
+     *              could not be allocated.
+     */
+    bool setGrayscale(uint8_t bits) {
+        if (bitmap == nullptr || bits == 1 || bits > 4 || (bits && front != nullptr)) {
+            return false;
+        }
+        free(planes);
+        planes = nullptr;
+        grayBits = 0;
+        if (bits) {
+            // lower bit planes of the frame buffer and the displayed bit planes
+            planes = (uint8_t *)malloc((2 * bits - 1) * bitmapSize);
+            if (planes == nullptr) {
+                return false;
+            }
+            grayBits = bits;
+            grayFront = planes + (bits - 1) * bitmapSize;
+            grayPlane = bits - 1;
+            grayTicks = 1;
+            grayLastStep = micros();
+            memset(&grayStats, 0, sizeof(grayStats));
+        }
+        fillScreen(0);
+        if (grayBits) {
+            flush();
+        }
+        return true;
+    }
+
+    /*! Advance the grayscale cycle by one step
+     *
+     * Transmits the next bit plane if the display time of the current plane has elapsed. Only
+     * rows that differ from the currently displayed plane are transmitted.
+     *
+     * @return `true` if a bit plane was transmitted, `false` otherwise.
+     */
+    bool grayStep() {
+        if (!grayBits) {
+            return false;
+        }
+        unsigned long now = micros();
+        if (now - grayLastStep > grayStats.maxInterval && grayStats.planes) {
+            grayStats.maxInterval = now - grayLastStep;
+        }
+        grayLastStep = now;
+        if (--grayTicks) {
+            return false;
+        }
+        if (++grayPlane == grayBits) {
+            grayPlane = 0;
+            grayStats.cycles++;
+        }
+        grayTicks = 1 << (grayBits - 1 - grayPlane);
+        const uint8_t *source = grayFront + grayPlane * bitmapSize;
+        if (output != nullptr) {
+            transformLayout(source, output);
+            source = output;
+        }
+        for (uint8_t offset = 8; offset > 0; offset--) {
+            sendRow(offset - 1, source);
+        }
+        refresh = false;
+        unsigned long planeTime = micros() - now;
+        if (planeTime > grayStats.maxPlaneTime) {
+            grayStats.maxPlaneTime = planeTime;
+        }
+        grayStats.planes++;
+        return true;
+    }
+
+    /*! Get the statistic counters of the grayscale mode
+     *
+     * The grayscale mode is flicker free, if `maxPlaneTime` is shorter than the interval between
+     * two steps and `maxInterval * (2^bits - 1)` is shorter than 10 milliseconds.
+     *
+     * @return The statistic counters accumulated since grayscale mode was enabled or the last
+     *         call to \ref resetGrayscaleStats()
+     */
+    inline const GrayscaleStats &getGrayscaleStats() const {
+        return grayStats;
+    }
+
+    /*! Reset the statistic counters of the grayscale mode */
+    void resetGrayscaleStats() {
+        memset(&grayStats, 0, sizeof(grayStats));
+    }
+
+    /*! Forces the next flush to transmit the complete frame buffer
+     *
+     * Use this method if the content of the displays may not reflect the last transmitted frame
+     * buffer anymore, e.g. after a power failure of the modules.
+     */
+    void invalidate() {
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            drivers[chain]->invalidate();
+        }
+        refresh = true;
     }
 
     /*! Define how the displays are ordered.
@@ -130,6 +535,7 @@ class Max72xxMatrix : public Adafruit_GFX {
     void setPosition(uint8_t display, uint8_t x, uint8_t y) {
         if (bitmap != nullptr) {
             matrixPosition[x + hDisplays * y] = display;
+            updateLayout();
         }
     }
 
@@ -144,6 +550,7 @@ class Max72xxMatrix : public Adafruit_GFX {
     void setRotation(uint8_t display, uint8_t rotation) {
         if (bitmap != nullptr) {
             matrixRotation[display] = rotation;
+            updateLayout();
         }
     }
 
@@ -203,14 +610,37 @@ class Max72xxMatrix : public Adafruit_GFX {
      *                  box is adjusted to a multiple of this value
      * @return          `true` if the string fits the defined space, `false` if output was truncated
      */
-    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, String content,
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const String &content,
+                        uint8_t baseLine, uint8_t yAdvance = 0) {
+        return printFormatted(x, y, w, align, content.c_str(), baseLine, yAdvance);
+    }
+
+    /*! Prints a text at a specified location with a specified formatting
+     *
+     * This method prints a text at the specified location with the specified length using left,
+     * right or centered alignment. All parameters are checked for plasibility and will be adapted
+     * to the current display size.
+     *
+     * The text is rendered directly into the frame buffer clipped to the specified area, so no
+     * memory is allocated.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The string to print
+     * @param baseLine  The distance between baseline and topline
+     * @param yAdvance  The newline distance - If specified, the height of the calculated bounding
+     *                  box is adjusted to a multiple of this value
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const char *content,
                         uint8_t baseLine, uint8_t yAdvance = 0) {
         int16_t xx = 0, yy = 0;
         uint16_t ww = 0, hh = 0;
         bool old_wrap = wrap;
         wrap = false;
         getTextBounds(content, 0, 0, &xx, &yy, &ww, &hh);
-        wrap = old_wrap;
 
         switch (align) {
         default:
@@ -230,22 +660,332 @@ class Max72xxMatrix : public Adafruit_GFX {
         if (yAdvance && (hh % yAdvance)) {
             hh = ((hh / yAdvance) + 1) * yAdvance;
         }
-        GFXcanvas1 tmp(w, hh);
-        if (gfxFont) {
-            tmp.setFont(gfxFont);
-        }
-        tmp.fillScreen(textbgcolor);
-        tmp.setTextWrap(false);
-        tmp.setCursor(xx, baseLine ? baseLine : -1 * yy);
-        tmp.setTextColor(textcolor, textbgcolor);
-        tmp.print(content);
-        // fillRect(x, y, w, hh, textbgcolor);
-        drawBitmap(x, y, tmp.getBuffer(), w, hh, textcolor, textbgcolor);
-        // set cursor after last printed character
-        setCursor(x + tmp.getCursorX(), y + (baseLine ? baseLine : -1 * yy));
+        // clear the area and render the text clipped to it
+        fillRect(x, y, w, hh, textbgcolor);
+        setClipRect(x, y, w, hh);
+        setCursor(x + xx, y + (baseLine ? baseLine : -1 * yy));
+        print(content);
+        clearClipRect();
+        wrap = old_wrap;
+        // the cursor remains after the last printed character
         return w >= (int16_t)ww;
     }
 
+    /*! Draws a window of columns of an off-screen strip
+     *
+     * The columns `offset` to `offset + w - 1` of the strip are copied to the display at the
+     * specified position. Columns outside the strip are drawn with the background color. If the
+     * display is not rotated and `y` is a multiple of 8, the columns are copied as whole bytes.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in pixels
+     * @param strip     The strip to copy from
+     * @param offset    The first column of the strip to copy
+     * @param color     Binary (on or off) color to draw the set pixels with
+     * @param bg        Binary (on or off) color to draw the unset pixels with
+     */
+    void drawStrip(int16_t x, int16_t y, int16_t w, const Max72xxStrip &strip, int16_t offset,
+                   uint16_t color, uint16_t bg) {
+        if (bitmap == nullptr) {
+            return;
+        }
+        int16_t h = strip.height();
+        if (rotation || (y & 0b111) || clipping || grayBits) {
+            // no byte aligned copy possible
+            for (int16_t i = 0; i < w; i++) {
+                for (int16_t j = 0; j < h; j++) {
+                    bool set = strip.getColumn(offset + i, j >> 3) & (1 << (j & 0b111));
+                    Max72xxMatrix::drawPixel(x + i, y + j, set ? color : bg);
+                }
+            }
+            return;
+        }
+        for (int16_t i = 0; i < w; i++) {
+            int16_t dx = x + i;
+            if (dx < 0 || dx >= WIDTH) {
+                continue;
+            }
+            for (int16_t band = 0; (band << 3) < h; band++) {
+                int16_t dy = y + (band << 3);
+                if (dy < 0) {
+                    continue;
+                }
+                if (dy >= HEIGHT) {
+                    break;
+                }
+                uint8_t value = strip.getColumn(offset + i, band);
+                value = (color ? value : 0) | (bg ? ~value : 0);
+                uint8_t rows = h - (band << 3);
+                writeColumn(dx, dy >> 3, value, rows >= 8 ? 0xff : 0xff >> (8 - rows));
+            }
+        }
+    }
+
+  private:
+    void flush() {
+        if (bitmap == nullptr) {
+            return;
+        }
+        if (grayBits) {
+            // the bit planes are transmitted by grayStep()
+            memcpy(grayFront, bitmap, bitmapSize);
+            memcpy(grayFront + bitmapSize, planes, (grayBits - 1) * bitmapSize);
+            return;
+        }
+        if (front != nullptr) {
+            if (output != nullptr) {
+                transformLayout(bitmap, front);
+            } else {
+                memcpy(front, bitmap, bitmapSize);
+            }
+            pending = 0xff;
+            return;
+        }
+        const uint8_t *source = bitmap;
+        if (output != nullptr) {
+            transformLayout(bitmap, output);
+            source = output;
+        }
+        for (uint8_t offset = 8; offset > 0; offset--) {
+            sendRow(offset - 1, source);
+        }
+        refresh = false;
+    }
+
+    void init(uint8_t chains, const uint8_t *csPins, SPIClass **pSPIs, uint8_t rotation) {
+        uint16_t displays = hDisplays * (HEIGHT >> 3);
+        bitmapSize = displays * 8;
+        bitmap = (uint8_t *)malloc((2 * bitmapSize) + (4 * displays));
+        drivers = (Max72XX **)malloc(chains * sizeof(Max72XX *));
+        output = nullptr;
+        front = nullptr;
+        clipping = false;
+        frameDepth = 0;
+        framePending = false;
+        framePeriod = 0;
+        frameLast = 0;
+        grayBits = 0;
+        planes = nullptr;
+        pending = 0;
+        refresh = true;
+        // distribute the displays in equal blocks over the chains
+        chainLen = chains ? (displays + chains - 1) / chains : 0;
+        if (displays > maxDisplays || chainLen > Max72XX::maxChainLen) {
+            // the modules beyond the chain limit would never receive data
+            free(bitmap);
+            bitmap = nullptr;
+            chainLen = 0;
+        }
+        this->chains = 0;
+        if (drivers != nullptr && chainLen) {
+            for (uint16_t first = 0; first < displays; first += chainLen) {
+                uint8_t chain = this->chains++;
+                uint16_t devices = displays - first < chainLen ? displays - first : chainLen;
+                drivers[chain] = new Max72XX(csPins[chain], devices,
+                                             pSPIs != nullptr ? pSPIs[chain] : &SPI);
+            }
+        }
+        if (bitmap == nullptr) {
+            return;
+        }
+        shadow = bitmap + bitmapSize;
+        matrixPosition = shadow + bitmapSize;
+        matrixRotation = matrixPosition + displays;
+        matrixLayout = (uint16_t *)(matrixRotation + displays);
+        for (uint16_t display = 0; display < displays; display++) {
+            matrixPosition[display] = display;
+            matrixRotation[display] = rotation;
+        }
+        updateLayout();
+    }
+
+    void updateLayout() {
+        // for every module slot of the canvas: offset of the assigned display in the bitmap
+        // (multiple of 8) combined with its rotation. In logical layout every slot is an
+        // unrotated display in natural order.
+        uint16_t displays = bitmapSize >> 3;
+        for (uint16_t slot = 0; slot < displays; slot++) {
+            uint8_t display = matrixPosition[slot];
+            if (output != nullptr) {
+                matrixLayout[slot] = slot << 3;
+            } else {
+                matrixLayout[slot] = (display << 3) | (matrixRotation[display] & 3);
+            }
+        }
+    }
+
+    void transformLayout(const uint8_t *source, uint8_t *target) {
+        // applies the module order and rotation to a frame buffer in logical layout
+        uint16_t displays = bitmapSize >> 3;
+        for (uint16_t slot = 0; slot < displays; slot++) {
+            uint8_t display = matrixPosition[slot];
+            rotateModule(source + (slot << 3), target + (display << 3), matrixRotation[display]);
+        }
+    }
+
+    inline void setBits(uint8_t *ptr, uint8_t mask, uint16_t color) {
+        // sets or clears the masked bits of a frame buffer byte in all bit planes
+        if (!grayBits) {
+            if (color) {
+                *ptr |= mask;
+            } else {
+                *ptr &= ~mask;
+            }
+            return;
+        }
+        uint16_t offset = ptr - bitmap;
+        for (uint8_t plane = 0; plane < grayBits; plane++) {
+            uint8_t *pPlane = plane ? planes + (plane - 1) * bitmapSize + offset : ptr;
+            if (color & (1 << (grayBits - 1 - plane))) {
+                *pPlane |= mask;
+            } else {
+                *pPlane &= ~mask;
+            }
+        }
+    }
+
+    static void rotateModule(const uint8_t *src, uint8_t *dst, uint8_t rotation) {
+        // the module is an 8x8 bit matrix: byte c is column c, bit r is row r
+        switch (rotation & 3) {
+        case 0:
+            memcpy(dst, src, 8);
+            break;
+        case 1:
+        case 3: {
+            // bit parallel transpose of the 8x8 bit matrix in a 64 bit word
+            uint64_t x = 0, t;
+            for (uint8_t c = 0; c < 8; c++) {
+                x |= (uint64_t)src[c] << (c << 3);
+            }
+            t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+            x = x ^ t ^ (t << 7);
+            t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+            x = x ^ t ^ (t << 14);
+            t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+            x = x ^ t ^ (t << 28);
+            for (uint8_t c = 0; c < 8; c++, x >>= 8) {
+                if (rotation == 1) {
+                    // 90 degrees: reversed column order
+                    dst[7 - c] = (uint8_t)x;
+                } else {
+                    // 270 degrees: reversed row order
+                    dst[c] = reverseBits((uint8_t)x);
+                }
+            }
+            break;
+        }
+        case 2:
+            // 180 degrees: reversed column and row order
+            for (uint8_t c = 0; c < 8; c++) {
+                dst[7 - c] = reverseBits(src[c]);
+            }
+            break;
+        }
+    }
+
+    static inline uint8_t reverseBits(uint8_t b) {
+        b = (b >> 4) | (b << 4);
+        b = ((b & 0xcc) >> 2) | ((b & 0x33) << 2);
+        return ((b & 0xaa) >> 1) | ((b & 0x55) << 1);
+    }
+
+    bool sendRow(uint8_t offset, const uint8_t *source) {
+        bool sent = false;
+        for (uint8_t chain = 0; chain < chains; chain++) {
+            uint16_t base = chain * chainLen * 8 + offset;
+            sent |= drivers[chain]->sendDigit(Max72XX::digit0 + offset, source + base,
+                                              shadow + base, 8, refresh);
+        }
+        return sent;
+    }
+
+    void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+        // restricts all drawing operations to the specified area in display coordinates
+        clipping = true;
+        clipX0 = x;
+        clipY0 = y;
+        clipX1 = x + w - 1;
+        clipY1 = y + h - 1;
+    }
+
+    inline void clearClipRect() {
+        clipping = false;
+    }
+
+    void writeColumn(int16_t x, int16_t band, uint8_t value, uint8_t mask) {
+        // writes the masked 8 vertically stacked pixels of a band at the physical column x
+        if (output != nullptr) {
+            // logical layout
+            uint8_t *ptr = bitmap + x + WIDTH * band;
+            *ptr = (*ptr & ~mask) | (value & mask);
+            return;
+        }
+        uint16_t layout = matrixLayout[(x >> 3) + hDisplays * band];
+        uint8_t *ptr = bitmap + (layout & ~0b111);
+        uint8_t lx = x & 0b111;
+        switch (layout & 3) {
+        default:
+        case 0:
+            ptr[lx] = (ptr[lx] & ~mask) | (value & mask);
+            break;
+        case 2:
+            mask = reverseBits(mask);
+            ptr[7 - lx] = (ptr[7 - lx] & ~mask) | (reverseBits(value) & mask);
+            break;
+        case 1:
+        case 3:
+            // the column becomes a row of the module
+            for (uint8_t ly = 0; ly < 8; ly++) {
+                if (mask & (1 << ly)) {
+                    uint8_t c = (layout & 3) == 1 ? 7 - ly : ly;
+                    uint8_t bit = 1 << ((layout & 3) == 1 ? lx : 7 - lx);
+                    if (value & (1 << ly)) {
+                        ptr[c] |= bit;
+                    } else {
+                        ptr[c] &= ~bit;
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        // fills the module bytes covered by the clipped physical area x0,y0 - x1,y1 (inclusive)
+        for (int16_t sy = y0 >> 3; sy <= y1 >> 3; sy++) {
+            uint8_t ly0 = sy == y0 >> 3 ? y0 & 0b111 : 0;
+            uint8_t ly1 = sy == y1 >> 3 ? y1 & 0b111 : 7;
+            for (int16_t sx = x0 >> 3; sx <= x1 >> 3; sx++) {
+                uint8_t lx0 = sx == x0 >> 3 ? x0 & 0b111 : 0;
+                uint8_t lx1 = sx == x1 >> 3 ? x1 & 0b111 : 7;
+                uint16_t layout = matrixLayout[sx + hDisplays * sy];
+                // columns and row bits of the area inside the rotated module
+                uint8_t c0, c1, b0, b1;
+                switch (layout & 3) {
+                default:
+                case 0:
+                    c0 = lx0, c1 = lx1, b0 = ly0, b1 = ly1;
+                    break;
+                case 1:
+                    c0 = 7 - ly1, c1 = 7 - ly0, b0 = lx0, b1 = lx1;
+                    break;
+                case 2:
+                    c0 = 7 - lx1, c1 = 7 - lx0, b0 = 7 - ly1, b1 = 7 - ly0;
+                    break;
+                case 3:
+                    c0 = ly0, c1 = ly1, b0 = 7 - lx1, b1 = 7 - lx0;
+                    break;
+                }
+                uint8_t mask = (0xff >> (7 - b1)) & (0xff << b0);
+                uint8_t *ptr = bitmap + (layout & ~0b111);
+                for (uint8_t c = c0; c <= c1; c++) {
+                    setBits(ptr + c, mask, color);
+                }
+            }
+        }
+    }
+
   public:
     // overrides of virtual functions
 
@@ -253,8 +993,161 @@ class Max72xxMatrix : public Adafruit_GFX {
      * @param  color Binary (on or off) color to fill with
      */
     virtual void fillScreen(uint16_t color) {
-        if (bitmap != nullptr) {
+        if (bitmap == nullptr) {
+            return;
+        }
+        if (!grayBits) {
             memset(bitmap, color ? 0xff : 0, bitmapSize);
+            return;
+        }
+        for (uint8_t plane = 0; plane < grayBits; plane++) {
+            uint8_t *pPlane = plane ? planes + (plane - 1) * bitmapSize : bitmap;
+            memset(pPlane, color & (1 << (grayBits - 1 - plane)) ? 0xff : 0, bitmapSize);
+        }
+    }
+
+    /*! Fill a rectangle completely with one color
+     *
+     * The rectangle is written as masked byte operations on the modules instead of drawing
+     * every single pixel.
+     *
+     * @param x     Top left corner x coordinate
+     * @param y     Top left corner y coordinate
+     * @param w     Width in pixels
+     * @param h     Height in pixels
+     * @param color Binary (on or off) color to fill with
+     */
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (bitmap == nullptr) {
+            return;
+        }
+        if (w < 0) {
+            x += w + 1;
+            w = -w;
+        }
+        if (h < 0) {
+            y += h + 1;
+            h = -h;
+        }
+        if (!w || !h) {
+            return;
+        }
+        int16_t x1 = x + w - 1;
+        int16_t y1 = y + h - 1;
+        int16_t tmp;
+
+        if (clipping) {
+            x = x < clipX0 ? clipX0 : x;
+            y = y < clipY0 ? clipY0 : y;
+            x1 = x1 > clipX1 ? clipX1 : x1;
+            y1 = y1 > clipY1 ? clipY1 : y1;
+            if (x > x1 || y > y1) {
+                return;
+            }
+        }
+
+        if (rotation) {
+            // Implement Adafruit's rotation.
+            if (rotation >= 2) {
+                // rotation == 2 || rotation == 3
+                tmp = x;
+                x = _width - 1 - x1;
+                x1 = _width - 1 - tmp;
+            }
+
+            if (rotation == 1 || rotation == 2) {
+                // rotation == 1 || rotation == 2
+                tmp = y;
+                y = _height - 1 - y1;
+                y1 = _height - 1 - tmp;
+            }
+
+            if (rotation & 1) {
+                // rotation == 1 || rotation == 3
+                tmp = x;
+                x = y;
+                y = tmp;
+                tmp = x1;
+                x1 = y1;
+                y1 = tmp;
+            }
+        }
+
+        // Clip to the canvas.
+        x = x < 0 ? 0 : x;
+        y = y < 0 ? 0 : y;
+        x1 = x1 >= WIDTH ? WIDTH - 1 : x1;
+        y1 = y1 >= HEIGHT ? HEIGHT - 1 : y1;
+        if (x <= x1 && y <= y1) {
+            fillArea(x, y, x1, y1, color);
+        }
+    }
+
+    /*! Draw a perfectly horizontal line
+     * @param x     Left-most x coordinate
+     * @param y     Left-most y coordinate
+     * @param w     Width in pixels
+     * @param color Binary (on or off) color to draw with
+     */
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+    /*! Draw a perfectly vertical line
+     * @param x     Top-most x coordinate
+     * @param y     Top-most y coordinate
+     * @param h     Height in pixels
+     * @param color Binary (on or off) color to draw with
+     */
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+    using Adafruit_GFX::drawBitmap;
+
+    /*! Draw a RAM-resident 1-bit image at the specified (x,y) position, using the specified
+     * foreground color (unset bits are transparent).
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param source    Byte array with monochrome bitmap
+     * @param w         Width of bitmap in pixels
+     * @param h         Height of bitmap in pixels
+     * @param color     Binary (on or off) color to draw with
+     */
+    void drawBitmap(int16_t x, int16_t y, uint8_t *source, int16_t w, int16_t h, uint16_t color) {
+        int16_t byteWidth = (w + 7) / 8;
+        for (int16_t j = 0; j < h; j++, source += byteWidth) {
+            for (int16_t i = 0; i < w; i += 8) {
+                uint8_t b = source[i >> 3];
+                // skip empty bytes as a whole
+                for (uint8_t k = 0; b && i + k < w; k++, b <<= 1) {
+                    if (b & 0x80) {
+                        Max72xxMatrix::drawPixel(x + i + k, y + j, color);
+                    }
+                }
+            }
+        }
+    }
+
+    /*! Draw a RAM-resident 1-bit image at the specified (x,y) position, using the specified
+     * foreground (for set bits) and background (unset bits) colors.
+     *
+     * The background is filled with byte operations, so only the foreground pixels are drawn one
+     * by one.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param source    Byte array with monochrome bitmap
+     * @param w         Width of bitmap in pixels
+     * @param h         Height of bitmap in pixels
+     * @param color     Binary (on or off) color to draw pixels with
+     * @param bg        Binary (on or off) color to draw background with
+     */
+    void drawBitmap(int16_t x, int16_t y, uint8_t *source, int16_t w, int16_t h, uint16_t color,
+                    uint16_t bg) {
+        fillRect(x, y, w, h, bg);
+        if (color != bg) {
+            drawBitmap(x, y, source, w, h, color);
         }
     }
 
@@ -268,13 +1161,16 @@ class Max72xxMatrix : public Adafruit_GFX {
             return;
         }
 
-        // Operating in bytes is faster and takes less code to run. We don't
-        // need values above 200, so switch from 16 bit ints to 8 bit unsigned
-        // ints (bytes).
-        // Keep xx as int16_t so fix 16 panel limit
+        // Keep x and y as int16_t since large displays can be wider or
+        // higher than 255 pixels
         int16_t x = xx;
-        uint8_t y = yy;
-        uint8_t tmp;
+        int16_t y = yy;
+        int16_t tmp;
+
+        if (clipping && (x < clipX0 || x > clipX1 || y < clipY0 || y > clipY1)) {
+            // Ignore pixels outside the clipping area.
+            return;
+        }
 
         if (rotation) {
             // Implement Adafruit's rotation.
@@ -301,43 +1197,26 @@ class Max72xxMatrix : public Adafruit_GFX {
             return;
         }
 
-        // Translate the x, y coordinate according to the layout of the
-        // displays. They can be ordered and rotated (0, 90, 180, 270).
-
-        uint8_t display = matrixPosition[(x >> 3) + hDisplays * (y >> 3)];
-        x &= 0b111;
-        y &= 0b111;
+        uint8_t *ptr;
+        uint8_t val;
 
-        uint8_t r = matrixRotation[display];
-        if (r >= 2) {
-            // 180 or 270 degrees
-            x = 7 - x;
-        }
-        if (r == 1 || r == 2) {
-            // 90 or 180 degrees
-            y = 7 - y;
-        }
-        if (r & 1) {
-            // 90 or 270 degrees
-            tmp = x;
-            x = y;
-            y = tmp;
+        if (output != nullptr) {
+            // Logical layout: the displays are applied when writing
+            ptr = bitmap + x + WIDTH * (y >> 3);
+            val = 1 << (y & 0b111);
+        } else {
+            // Translate the x, y coordinate according to the layout of the
+            // displays. They can be ordered and rotated (0, 90, 180, 270).
+            uint16_t layout = matrixLayout[(x >> 3) + hDisplays * (y >> 3)];
+            uint8_t pos = pgm_read_byte(max72xxPixelMap + ((layout & 3) << 6) +
+                                        ((y & 0b111) << 3) + (x & 0b111));
+            ptr = bitmap + (layout & ~0b111) + (pos >> 3);
+            val = 1 << (pos & 0b111);
         }
 
-        uint8_t d = display / hDisplays;
-        x += (display - d * hDisplays) << 3;  // x += (display % hDisplays) * 8
-        y += d << 3;                          // y += (display / hDisplays) * 8
-
         // Update the color bit in our bitmap buffer.
 
-        uint8_t *ptr = bitmap + x + WIDTH * (y >> 3);
-        uint8_t val = 1 << (y & 0b111);
-
-        if (color) {
-            *ptr |= val;
-        } else {
-            *ptr &= ~val;
-        }
+        setBits(ptr, val, color);
     }
 };
 }  // namespace ustd
\ No newline at end of file
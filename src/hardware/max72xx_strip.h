@@ -0,0 +1,94 @@
+// max72xx_strip.h - off-screen monochrome canvas in MAX72XX matrix layout
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+namespace ustd {
+
+/*! \brief The MAX72XX Off-screen Strip Class
+ *
+ * This class derived from Adafruit's core graphics class provides a monochrome off-screen canvas
+ * organized like the frame buffer of \ref Max72xxMatrix: every byte contains 8 vertically
+ * stacked pixels (the least significant bit is the topmost pixel) and the bytes of a band of 8
+ * rows are stored column by column. Content rendered into a strip can be copied column-wise into a
+ * \ref Max72xxMatrix with \ref Max72xxMatrix::drawStrip() - e.g. in order to scroll a text that
+ * was rendered only once.
+ *
+ * Display rotation is not supported.
+ */
+class Max72xxStrip : public Adafruit_GFX {
+  private:
+    uint8_t *buffer;
+
+  public:
+    /*! Instantiate a Max72xxStrip instance
+     * @param w Width of the strip in pixels
+     * @param h Height of the strip in pixels
+     */
+    Max72xxStrip(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+        buffer = (uint8_t *)malloc(getBufferSize());
+        fillScreen(0);
+    }
+
+    virtual ~Max72xxStrip() {
+        free(buffer);
+    }
+
+    /*! Get the frame buffer
+     * @return The frame buffer or `nullptr` if the allocation failed
+     */
+    inline const uint8_t *getBuffer() const {
+        return buffer;
+    }
+
+    /*! Get the size of the frame buffer
+     * @return The size of the frame buffer in bytes
+     */
+    inline uint16_t getBufferSize() const {
+        return WIDTH * ((HEIGHT + 7) >> 3);
+    }
+
+    /*! Get 8 vertically stacked pixels
+     * @param x     x coordinate of the column
+     * @param band  Index of the band of 8 rows
+     * @return      The pixels of the column in the specified band. Pixels outside the strip are
+     *              reported as not set.
+     */
+    inline uint8_t getColumn(int16_t x, uint8_t band) const {
+        if (buffer == nullptr || x < 0 || x >= WIDTH || band >= (HEIGHT + 7) >> 3) {
+            return 0;
+        }
+        return buffer[x + WIDTH * band];
+    }
+
+    // overrides of virtual functions
+
+    /*! Fill the framebuffer completely with one color
+     * @param  color Binary (on or off) color to fill with
+     */
+    virtual void fillScreen(uint16_t color) {
+        if (buffer != nullptr) {
+            memset(buffer, color ? 0xff : 0, getBufferSize());
+        }
+    }
+
+    /*! Draw a pixel to the canvas framebuffer
+     * @param x     x coordinate
+     * @param y     y coordinate
+     * @param color Binary (on or off) color to draw with
+     */
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer == nullptr || x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) {
+            return;
+        }
+        uint8_t *ptr = buffer + x + WIDTH * (y >> 3);
+        uint8_t val = 1 << (y & 0b111);
+        if (color) {
+            *ptr |= val;
+        } else {
+            *ptr &= ~val;
+        }
+    }
+};
+}  // namespace ustd
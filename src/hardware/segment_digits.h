@@ -0,0 +1,374 @@
+// segment_digits.h - text and number formatting shared by the segment digits drivers
+
+#pragma once
+
+#include <Arduino.h>
+
+namespace ustd {
+
+/*! \brief Common base of the Segment Digits Display Classes
+ *
+ * This class derived from `Print` class implements the cursor handling, the character mapping and
+ * the text and number formatting shared by all segment digits drivers. The glyphs are looked up
+ * in the font table set up by the driver: `font` for 8 bit glyphs or `wideFont` for 16 bit
+ * glyphs, both covering the characters 0x20 to 0x7F. If `dpMask` is not zero, dots and commas
+ * are merged into the preceding digit using this segment mask, otherwise they occupy a digit
+ * position of their own.
+ *
+ * The driver class `TDigits` passes itself as template parameter and implements the frame buffer
+ * access:
+ *
+ * * `void setChar(uint16_t index, uint32_t code)` - set the segments of the digit at `index`
+ * * `void mergeChar(uint16_t index, uint32_t code)` - add segments to the digit at `index`
+ *
+ * The digits are indexed row by row: `index = y * width() + x`.
+ */
+template <class TDigits> class SegmentDigits : public Print {
+  protected:
+    // runtime - text logic
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    bool wrap;
+    uint32_t dpMask;
+    const uint8_t *font;
+    const uint16_t *wideFont;
+
+  public:
+    SegmentDigits()
+        : _width(0), _height(0), cursor_x(0), cursor_y(0), wrap(true), dpMask(0), font(nullptr),
+          wideFont(nullptr) {
+    }
+
+    /*! Set text cursor location
+     * @param x X coordinate in digit positions
+     * @param y Y coordinate in digit positions
+     */
+    void setCursor(int16_t x, int16_t y) {
+        cursor_x = x;
+        cursor_y = y;
+    }
+
+    /*! Set text cursor X location
+     * @param x X coordinate in digit positions
+     */
+    inline void setCursorX(int16_t x) {
+        cursor_x = x;
+    }
+
+    /*! Set text cursor Y location
+     * @param y Y coordinate in digit positions
+     */
+    inline void setCursorY(int16_t y) {
+        cursor_y = y;
+    }
+
+    /*! Set whether text that is too long for the screen width should
+     *      automatically wrap around to the next line (else clip right).
+     * @param w true for wrapping, false for clipping
+     */
+    void setTextWrap(bool w) {
+        wrap = w;
+    }
+
+    /*! Fill a rectangle completely with one pattern.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param h         Height in digit positions
+     * @param pattern   Segment pattern to fill the area with
+     */
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t pattern = 0) {
+        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
+        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
+        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
+        h = h < 0 ? 0 : h >= _height - y ? _height - y : h;
+
+        for (int16_t yy = y; yy < y + h; yy++) {
+            for (int16_t xx = x; xx < x + w; xx++) {
+                self().setChar(yy * _width + xx, pattern);
+            }
+        }
+    }
+
+    /*! Prints a text at a specified location with a specified formatting
+     *
+     * This method prints a text at the specified location with the specified length using left,
+     * right or centered alignment. All parameters are checked for plasibility and will be adapted
+     * to the current display size.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The string to print
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const String &content) {
+        return printFormatted(x, y, w, align, content.c_str(), content.length());
+    }
+
+    /*! Prints a text at a specified location with a specified formatting
+     *
+     * This method prints a text at the specified location with the specified length using left,
+     * right or centered alignment. All parameters are checked for plasibility and will be adapted
+     * to the current display size.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The zero terminated string to print
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const char *content) {
+        return printFormatted(x, y, w, align, content, strlen(content));
+    }
+
+    /*! Prints a text at a specified location with a specified formatting
+     *
+     * This method prints a text at the specified location with the specified length using left,
+     * right or centered alignment. All parameters are checked for plasibility and will be adapted
+     * to the current display size.
+     *
+     * The text is measured first and then mapped directly into the frame buffer, so the length of
+     * the text is not limited and no memory is allocated.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The string to print - does not need to be zero terminated
+     * @param len       Number of characters of `content` to print
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const char *content,
+                        uint16_t len) {
+        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
+        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
+        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
+        fillRect(x, y, w, 1);
+        const unsigned char *pSrc = (const unsigned char *)content;
+        int16_t size = 0;
+        for (uint16_t i = 0; i < len; i++) {
+            size += getCharLen(pSrc[i], size == 0);
+        }
+        int16_t skip = 0;  // number of leading digit positions that do not fit
+        int16_t offs = 0;
+        int16_t newx = x;
+        switch (align) {
+        default:
+        case 0:
+            // left
+            newx = x + min(w, size);
+            break;
+        case 1:
+            // center
+            if (w < size) {
+                // string is larger than slot size - display only middle part
+                skip = (size - w) / 2;
+                newx = x + size - skip;
+            } else {
+                // string is smaller than slot size - display center aligned
+                offs = (w - size) / 2;
+                newx = x + size + offs;
+            }
+            break;
+        case 2:
+            // right
+            if (w < size) {
+                // string is larger than slot size - display only last part
+                skip = size - w;
+            } else {
+                // string is smaller than slot size - display right aligned
+                offs = w - size;
+            }
+            newx = x + w;
+            break;
+        }
+        int16_t count = min(w, size);
+        uint16_t dst = y * _width + x + offs;  // fist position of the destination slot
+        int16_t pos = -skip;
+        for (uint16_t i = 0; i < len; i++) {
+            if (pSrc[i] < 32) {
+                continue;
+            } else if (dpMask && (pSrc[i] == '.' || pSrc[i] == ',') && pos > -skip) {
+                if (pos > 0 && pos <= count) {
+                    self().mergeChar(dst + pos - 1, dpMask);
+                }
+                continue;
+            }
+            if (pos >= 0 && pos < count) {
+                self().setChar(dst + pos, dpMask && (pSrc[i] == '.' || pSrc[i] == ',')
+                                              ? dpMask
+                                              : mapchar(pSrc[i]));
+            }
+            pos++;
+        }
+        // set cursor after last printed character
+        setCursor(min(_width, newx), y);
+        return size <= w;
+    }
+
+    /*! Prints a number at a specified location with a specified formatting
+     *
+     * The number is converted directly into segment codes without any intermediate string. The
+     * value is interpreted as fixed point number with the specified number of decimals, e.g.
+     * `printNumber(0, 0, 8, -1234, 2)` displays `-12.34`. If the digits have a decimal point,
+     * it is merged into the last integer digit.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param value     The fixed point value to print
+     * @param decimals  Number of decimals contained in `value` (0..9, default: 0)
+     * @param align     Alignment of the number: 0 = left, 1 = center, 2 = right (default: 2)
+     * @return          `true` if the number fits the defined space, `false` if the number is too
+     *                  large - in this case the area is left blank.
+     */
+    bool printNumber(int16_t x, int16_t y, int16_t w, int32_t value, uint8_t decimals = 0,
+                     int16_t align = 2) {
+        uint32_t codes[12];  // least significant first: 10 digits, decimal point and sign
+        x = x < 0 ? 0 : x >= _width ? _width - 1 : x;
+        y = y < 0 ? 0 : y >= _height ? _height - 1 : y;
+        w = w < 0 ? 0 : w >= _width - x ? _width - x : w;
+        fillRect(x, y, w, 1);
+        if (decimals > 9) {
+            return false;
+        }
+        uint32_t number = value < 0 ? 0 - (uint32_t)value : value;
+        uint8_t size = 0;
+        uint8_t digit = 0;
+        do {
+            uint32_t code = mapchar('0' + number % 10);
+            if (decimals && digit == decimals) {
+                if (dpMask) {
+                    code |= dpMask;
+                } else {
+                    codes[size++] = mapchar('.');
+                }
+            }
+            codes[size++] = code;
+            number /= 10;
+            digit++;
+        } while (number || digit <= decimals);
+        if (value < 0) {
+            codes[size++] = mapchar('-');
+        }
+        if (size > w) {
+            // overflow
+            setCursor(x, y);
+            return false;
+        }
+        int16_t offs = align == 1 ? (w - size) / 2 : align == 2 ? w - size : 0;
+        uint16_t dst = y * _width + x + offs;
+        for (uint8_t i = 0; i < size; i++) {
+            self().setChar(dst + i, codes[size - 1 - i]);
+        }
+        // set cursor after last printed character
+        setCursor(x + offs + size, y);
+        return true;
+    }
+
+    /*! Get width of the display
+     * @returns Width in number of digits
+     */
+    inline int16_t width() const {
+        return _width;
+    };
+
+    /*! Get height of the display
+     * @returns Height in number of rows
+     */
+    inline int16_t height() const {
+        return _height;
+    }
+
+    /*! Returns if too long text will be wrapped to the next line
+     * @returns Wrapping mode
+     */
+    inline bool getTextWrap() const {
+        return wrap;
+    }
+
+    /*! Get text cursor X location
+     * @returns X coordinate in digit positions
+     */
+    inline int16_t getCursorX() const {
+        return cursor_x;
+    }
+
+    /*! Get text cursor Y location
+     * @returns Y coordinate in digit positions
+     */
+    inline int16_t getCursorY() const {
+        return cursor_y;
+    };
+
+    /*! Calculates the length in digits of a char
+     * @param c         The ASCII character in question
+     * @param firstChar Set to true, if this is the first chat of a sequence (default: false)
+     */
+    uint8_t getCharLen(unsigned char c, bool firstChar = false) {
+        if (c < 32) {
+            return 0;
+        } else if (dpMask && (c == '.' || c == ',')) {
+            return firstChar ? 1 : 0;
+        }
+        return 1;
+    }
+
+  protected:
+    inline TDigits &self() {
+        return *static_cast<TDigits *>(this);
+    }
+
+    inline uint16_t mapchar(uint8_t c) const {
+        if (c < 0x20 || c >= 0x80) {
+            c = '_';
+        }
+        return wideFont != nullptr ? pgm_read_word_near(wideFont + c - 0x20)
+                                   : pgm_read_byte_near(font + c - 0x20);
+    }
+
+    virtual size_t write(uint8_t c) {
+        if (c == '\r') {
+            cursor_x = 0;
+        } else if (c == '\n') {
+            cursor_x = 0;
+            cursor_y++;
+        }
+        if (wrap && cursor_x >= _width) {
+            cursor_x = 0;
+            cursor_y++;
+        }
+        if (cursor_x >= _width || cursor_y >= _height) {
+            // out of viewport
+            return 1;
+        }
+        if (cursor_x < 0 || cursor_y < 0) {
+            // out of viewport but we must increment when char is prinatble
+            cursor_x += getCharLen(c, cursor_x == 0);
+            return 1;
+        }
+        uint16_t index = cursor_y * _width + cursor_x;
+        if (c < 32) {
+            return 1;
+        } else if (dpMask && (c == '.' || c == ',')) {
+            if (cursor_x == 0) {
+                self().setChar(index, dpMask);
+            } else {
+                self().mergeChar(index - 1, dpMask);
+                cursor_x--;
+            }
+        } else {
+            self().setChar(index, mapchar(c));
+        }
+        cursor_x++;
+        return 1;
+    }
+};
+
+}  // namespace ustd
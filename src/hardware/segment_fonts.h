@@ -0,0 +1,131 @@
+// segment_fonts.h - ASCII font tables for 7, 14 and 16 segment digits
+
+#pragma once
+
+#include <Arduino.h>
+
+namespace ustd {
+
+/*! \brief The 7 segment font variants
+ *
+ * The variants differ only in the glyphs of characters that have no natural 7 segment
+ * representation.
+ */
+enum Font7Seg {
+    font7SegStandard = 0,  ///< 'K', 'M' and 'W' as on most seven segment clocks
+    font7SegAlternate = 1  ///< 'K', 'M' and 'W' distinguishable from 'H', 'N' and 'V'
+};
+
+/*! Convert a 7 segment code from MAX72XX layout into HT1621 layout
+ *
+ * The glyphs are defined in the segment layout of the MAX7219/MAX7221 no-decode mode:
+ * `B<DP><A><B><C><D><E><F><G>`. The HT1621 based LCDs expect the segments as
+ * `B<F><G><E><D><A><B><C><DP>`.
+ *
+ * @param s 7 segment code in MAX72XX layout
+ * @return  7 segment code in HT1621 layout
+ */
+constexpr uint8_t seg7ToHt1621(uint8_t s) {
+    return ((s & 0x80) >> 7) | ((s & 0x70) >> 3) | ((s & 0x08) << 1) | ((s & 0x04) << 3) |
+           ((s & 0x03) << 6);
+}
+
+// clang-format off
+// Glyphs of the characters 0x20 to 0x7F in MAX72XX layout. G(glyph) defines a character shared
+// by all font variants, V(standard, alternate) a character that differs between the variants.
+// Characters without a sensible representation are shown as underscore.
+#define USTD_FONT7SEG_GLYPHS(G, V) \
+    G(B00000000) /* 0x20   */ G(B10110000) /* 0x21 ! */ G(B00100010) /* 0x22 " */ G(B00001000) /* 0x23 # */ \
+    G(B01011011) /* 0x24 $ */ G(B00001000) /* 0x25 % */ G(B00001000) /* 0x26 & */ G(B00000010) /* 0x27 ' */ \
+    G(B01001110) /* 0x28 ( */ G(B01111000) /* 0x29 ) */ G(B00001000) /* 0x2A * */ G(B00001000) /* 0x2B + */ \
+    G(B10000000) /* 0x2C , */ G(B00000001) /* 0x2D - */ G(B10000000) /* 0x2E . */ G(B00100101) /* 0x2F / */ \
+    G(B01111110) /* 0x30 0 */ G(B00110000) /* 0x31 1 */ G(B01101101) /* 0x32 2 */ G(B01111001) /* 0x33 3 */ \
+    G(B00110011) /* 0x34 4 */ G(B01011011) /* 0x35 5 */ G(B01011111) /* 0x36 6 */ G(B01110000) /* 0x37 7 */ \
+    G(B01111111) /* 0x38 8 */ G(B01111011) /* 0x39 9 */ G(B00001000) /* 0x3A : */ G(B00001000) /* 0x3B ; */ \
+    G(B00001000) /* 0x3C < */ G(B00001001) /* 0x3D = */ G(B00001000) /* 0x3E > */ G(B11100101) /* 0x3F ? */ \
+    G(B00001000) /* 0x40 @ */ G(B01110111) /* 0x41 A */ G(B00011111) /* 0x42 B */ G(B00001101) /* 0x43 C */ \
+    G(B00111101) /* 0x44 D */ G(B01001111) /* 0x45 E */ G(B01000111) /* 0x46 F */ G(B01011110) /* 0x47 G */ \
+    G(B00110111) /* 0x48 H */ G(B00000110) /* 0x49 I */ G(B00111100) /* 0x4A J */ V(B00000111, B01010111) /* 0x4B K */ \
+    G(B00001110) /* 0x4C L */ V(B01110110, B01010101) /* 0x4D M */ G(B00010101) /* 0x4E N */ G(B00011101) /* 0x4F O */ \
+    G(B01100111) /* 0x50 P */ G(B11101110) /* 0x51 Q */ G(B00000101) /* 0x52 R */ G(B01011011) /* 0x53 S */ \
+    G(B00001111) /* 0x54 T */ G(B00111110) /* 0x55 U */ G(B00011100) /* 0x56 V */ V(B00011100, B00101011) /* 0x57 W */ \
+    G(B01001001) /* 0x58 X */ G(B00111011) /* 0x59 Y */ G(B01101101) /* 0x5A Z */ G(B01001110) /* 0x5B [ */ \
+    G(B00010011) /* 0x5C \ */ G(B01111000) /* 0x5D ] */ G(B01100010) /* 0x5E ^ */ G(B00001000) /* 0x5F _ */ \
+    G(B00100000) /* 0x60 ` */ G(B01110111) /* 0x61 a */ G(B00011111) /* 0x62 b */ G(B00001101) /* 0x63 c */ \
+    G(B00111101) /* 0x64 d */ G(B01001111) /* 0x65 e */ G(B01000111) /* 0x66 f */ G(B01011110) /* 0x67 g */ \
+    G(B00110111) /* 0x68 h */ G(B00000110) /* 0x69 i */ G(B00111100) /* 0x6A j */ V(B00000111, B01010111) /* 0x6B k */ \
+    G(B00001110) /* 0x6C l */ V(B01110110, B01010101) /* 0x6D m */ G(B00010101) /* 0x6E n */ G(B00011101) /* 0x6F o */ \
+    G(B01100111) /* 0x70 p */ G(B11101110) /* 0x71 q */ G(B00000101) /* 0x72 r */ G(B01011011) /* 0x73 s */ \
+    G(B00001111) /* 0x74 t */ G(B00111110) /* 0x75 u */ G(B00011100) /* 0x76 v */ V(B00011100, B00101011) /* 0x77 w */ \
+    G(B01001001) /* 0x78 x */ G(B00111011) /* 0x79 y */ G(B01101101) /* 0x7A z */ G(B01001110) /* 0x7B { */ \
+    G(B00000110) /* 0x7C | */ G(B01111000) /* 0x7D } */ G(B01000000) /* 0x7E ~ */ G(B00000000) /* 0x7F   */
+
+#define USTD_FONT7SEG_GLYPH(glyph) USTD_FONT7SEG_MAP(glyph),
+#define USTD_FONT7SEG_STANDARD(standard, alternate) USTD_FONT7SEG_MAP(standard),
+#define USTD_FONT7SEG_ALTERNATE(standard, alternate) USTD_FONT7SEG_MAP(alternate),
+
+#define USTD_FONT7SEG_MAP(glyph) glyph
+static const uint8_t max72xxFont7Seg[2][96] PROGMEM = {
+    {USTD_FONT7SEG_GLYPHS(USTD_FONT7SEG_GLYPH, USTD_FONT7SEG_STANDARD)},
+    {USTD_FONT7SEG_GLYPHS(USTD_FONT7SEG_GLYPH, USTD_FONT7SEG_ALTERNATE)}};
+#undef USTD_FONT7SEG_MAP
+
+#define USTD_FONT7SEG_MAP(glyph) seg7ToHt1621(glyph)
+static const uint8_t ht1621Font7Seg[2][96] PROGMEM = {
+    {USTD_FONT7SEG_GLYPHS(USTD_FONT7SEG_GLYPH, USTD_FONT7SEG_STANDARD)},
+    {USTD_FONT7SEG_GLYPHS(USTD_FONT7SEG_GLYPH, USTD_FONT7SEG_ALTERNATE)}};
+#undef USTD_FONT7SEG_MAP
+
+#undef USTD_FONT7SEG_GLYPH
+#undef USTD_FONT7SEG_STANDARD
+#undef USTD_FONT7SEG_ALTERNATE
+
+// 14 and 16 segment glyphs of the characters 0x20 to 0x7F generated by extras/segment-fonts.py.
+// ht1622Font16Seg contains the 16 segment glyphs in the display RAM layout of the HT1622 glass.
+static const uint16_t max72xxFont14Seg[] PROGMEM = {
+    0x0000, 0x4006, 0x0202, 0x12CE, 0x12ED, 0x0C24, 0x2359, 0x0200,  // 0x20
+    0x2400, 0x0900, 0x3FC0, 0x12C0, 0x0800, 0x00C0, 0x4000, 0x0C00,  // 0x28
+    0x0C3F, 0x0406, 0x00DB, 0x008F, 0x00E6, 0x2069, 0x00FD, 0x0007,  // 0x30
+    0x00FF, 0x00EF, 0x1200, 0x0A00, 0x2400, 0x00C8, 0x0900, 0x5083,  // 0x38
+    0x02BB, 0x00F7, 0x128F, 0x0039, 0x120F, 0x0079, 0x0071, 0x00BD,  // 0x40
+    0x00F6, 0x1209, 0x001E, 0x2470, 0x0038, 0x0536, 0x2136, 0x003F,  // 0x48
+    0x00F3, 0x203F, 0x20F3, 0x00ED, 0x1201, 0x003E, 0x0C30, 0x2836,  // 0x50
+    0x2D00, 0x1500, 0x0C09, 0x0039, 0x2100, 0x000F, 0x2800, 0x0008,  // 0x58
+    0x0100, 0x1058, 0x2078, 0x00D8, 0x088E, 0x0858, 0x0071, 0x048E,  // 0x60
+    0x00F4, 0x1000, 0x0A10, 0x3600, 0x0030, 0x10D4, 0x00D4, 0x00DC,  // 0x68
+    0x00F3, 0x00E7, 0x0050, 0x2088, 0x0078, 0x001C, 0x0810, 0x2814,  // 0x70
+    0x2D00, 0x028E, 0x0848, 0x1249, 0x1200, 0x1289, 0x02C0, 0x0000  // 0x78
+};
+
+static const uint16_t max72xxFont16Seg[] PROGMEM = {
+    0x0000, 0x0800, 0x0804, 0x4B3C, 0x4BBB, 0x3088, 0x8D73, 0x0800,  // 0x20
+    0x9000, 0x2400, 0xFF00, 0x4B00, 0x2000, 0x0300, 0x0010, 0x3000,  // 0x28
+    0x30FF, 0x100C, 0x0377, 0x023F, 0x038C, 0x81B3, 0x03FB, 0x000F,  // 0x30
+    0x03FF, 0x03BF, 0x4800, 0x2800, 0x9000, 0x0330, 0x2400, 0x4207,  // 0x38
+    0x0AF7, 0x03CF, 0x4A3F, 0x00F3, 0x483F, 0x01F3, 0x01C3, 0x02FB,  // 0x40
+    0x03CC, 0x4833, 0x007C, 0x91C0, 0x00F0, 0x14CC, 0x84CC, 0x00FF,  // 0x48
+    0x03C7, 0x80FF, 0x83C7, 0x03BB, 0x4803, 0x00FC, 0x30C0, 0xA0CC,  // 0x50
+    0xB400, 0x5400, 0x3033, 0x00F3, 0x8400, 0x003F, 0xA000, 0x0030,  // 0x58
+    0x0400, 0x4170, 0x81F0, 0x0370, 0x223C, 0x2170, 0x01C3, 0x123C,  // 0x60
+    0x03C8, 0x4000, 0x2840, 0xD800, 0x00C0, 0x4348, 0x0348, 0x0378,  // 0x68
+    0x03C7, 0x038F, 0x0140, 0x8230, 0x01F0, 0x0078, 0x2040, 0xA048,  // 0x70
+    0xB400, 0x0A3C, 0x2130, 0x4933, 0x4800, 0x4A33, 0x0B00, 0x0000  // 0x78
+};
+
+static const uint16_t ht1622Font16Seg[] PROGMEM = {
+    0x0000, 0x0080, 0x0480, 0xDCC8, 0xD9CD, 0x1224, 0x61DB, 0x0080,  // 0x20
+    0x2200, 0x0022, 0xAAAA, 0x8888, 0x0020, 0x0808, 0x0040, 0x0220,  // 0x28
+    0x5775, 0x1600, 0x4D59, 0x5D41, 0x1C0C, 0x614D, 0x595D, 0x1501,  // 0x30
+    0x5D5D, 0x5D4D, 0x8080, 0x00A0, 0x2200, 0x4848, 0x0022, 0x8D01,  // 0x38
+    0x4DD5, 0x1D1D, 0xDDC1, 0x4155, 0xD5C1, 0x415D, 0x011D, 0x5955,  // 0x40
+    0x1C1C, 0xC1C1, 0x5450, 0x221C, 0x4054, 0x1616, 0x3416, 0x5555,  // 0x48
+    0x0D1D, 0x7555, 0x2D1D, 0x594D, 0x8181, 0x5454, 0x0234, 0x3434,  // 0x50
+    0x2222, 0x8202, 0x4361, 0x4155, 0x2002, 0x5541, 0x2020, 0x4040,  // 0x58
+    0x0002, 0xC058, 0x605C, 0x4858, 0x5C60, 0x4078, 0x011D, 0x5E40,  // 0x60
+    0x181C, 0x8000, 0x00B0, 0xA280, 0x0014, 0x9818, 0x1818, 0x5858,  // 0x68
+    0x0D1D, 0x1D0D, 0x0018, 0x6840, 0x405C, 0x5050, 0x0030, 0x3030,  // 0x70
+    0x2222, 0x5CC0, 0x4068, 0xC1C9, 0x8080, 0xC9C1, 0x0888, 0x0000  // 0x78
+};
+// clang-format on
+
+}  // namespace ustd
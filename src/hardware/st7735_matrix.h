@@ -4,24 +4,116 @@
 
 #include "Adafruit_ST7735.h"
 
+#ifndef ST77XX_VSCRDEF
+#define ST77XX_VSCRDEF 0x33
+#endif
+#ifndef ST77XX_VSCRSADD
+#define ST77XX_VSCRSADD 0x37
+#endif
+
 namespace ustd {
 
+/*! \brief Glyph Cache for the Classic Font of Adafruit GFX
+ *
+ * The classic 5x7 font is private to the Adafruit GFX library. This helper obtains the columns
+ * of a glyph by drawing it with `Adafruit_GFX::drawChar()` into itself and keeps the recently
+ * used glyphs, so the row wise text renderer of \ref St7735Matrix decodes a character only once
+ * per text instead of once per pixel row.
+ */
+class St7735ClassicGlyphs : public Adafruit_GFX {
+  public:
+    /*! The number of cached glyphs */
+    static const uint8_t cacheSize = 16;
+
+  private:
+    int16_t tags[cacheSize];
+    uint8_t columns[cacheSize][5];
+    uint8_t *pCapture;
+
+  public:
+    /*! Instantiate an empty glyph cache
+     * @param codePage437 `true` if the correct code page 437 character mapping is used, see
+     *                    `Adafruit_GFX::cp437()`
+     */
+    St7735ClassicGlyphs(bool codePage437) : Adafruit_GFX(5, 8), pCapture(nullptr) {
+        cp437(codePage437);
+        for (uint8_t i = 0; i < cacheSize; i++) {
+            tags[i] = -1;
+        }
+    }
+
+    /*! Get the columns of a glyph
+     * @param c The character
+     * @return  Five columns with the pixel of row n in bit n
+     */
+    const uint8_t *get(unsigned char c) {
+        uint8_t slot = c % cacheSize;
+        if (tags[slot] != c) {
+            pCapture = columns[slot];
+            memset(pCapture, 0, 5);
+            // a background equal to the text color leaves the unset pixels alone
+            drawChar(0, 0, c, 1, 1, 1);
+            tags[slot] = c;
+        }
+        return columns[slot];
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x >= 0 && x < 5 && y >= 0 && y < 8 && color) {
+            pCapture[x] |= 1 << y;
+        }
+    }
+};
+
 /*! \brief The ST7735 Matrix Display Class
  *
  * This class derived from Adafruit's ST7735 TFT driver class provides an implementation of a TFT
  * dot matrix display based on the Sitronix ST7735 color single-chip TFT controller connected via
  * SPI.
  *
+ * Optionally the display can be operated with a frame buffer in RAM (see \ref setBuffered()). In
+ * this mode all graphic operations only modify the frame buffer and collect the changed areas in a
+ * short list of dirty rectangles. \ref write() transmits only these areas to the display.
+ *
+ * In portrait orientation a horizontal band of the display can be scrolled vertically by the
+ * controller (see \ref setScrollArea()). Scrolling by one pixel row only requires to set the new
+ * scroll start address and to draw the newly exposed row.
+ *
  * * See https://www.displayfuture.com/Display/datasheet/controller/ST7735.pdf
  * * See https://github.com/adafruit/Adafruit-ST7735-Library
  * * See https://learn.adafruit.com/1-8-tft-display/graphics-library
  * * See https://learn.adafruit.com/adafruit-gfx-graphics-library
  */
 class St7735Matrix : public Adafruit_ST7735 {
+  public:
+    /*! The maximum number of dirty rectangles collected between two flushes */
+    static const uint8_t maxDirtyRects = 8;
+
   protected:
+    // A rectangle with exclusive end coordinates
+    typedef struct {
+        int16_t x0;
+        int16_t y0;
+        int16_t x1;
+        int16_t y1;
+    } DirtyRect;
+
+    // Merging two rectangles is worth it if the union contains not more unchanged pixels than
+    // the bytes needed to set up an additional address window (11 bytes = ~6 pixels)
+    static const uint16_t mergeSlack = 6;
+
     uint8_t hardware;
     uint8_t rotation;
 
+    // frame buffer
+    uint16_t *buffer;
+    DirtyRect dirty[maxDirtyRects];
+    uint8_t dirtyCount;
+
+    // hardware scrolling
+    int16_t scrollTop;
+    int16_t scrollHeight;
+
   public:
     /*! Instantiate Adafruit ST7735 driver with default hardware SPI
      * @param csPin     Chip select pin #
@@ -34,11 +126,18 @@ class St7735Matrix : public Adafruit_ST7735 {
      *                  degrees and 90 degrees counter clockwise.
      */
     St7735Matrix(uint8_t csPin, uint8_t dcPin, uint8_t rsPin, uint8_t hardware, uint8_t rotation)
-        : Adafruit_ST7735(csPin, dcPin, rsPin), hardware(hardware), rotation(rotation) {
+        : Adafruit_ST7735(csPin, dcPin, rsPin), hardware(hardware), rotation(rotation),
+          buffer(nullptr), dirtyCount(0), scrollTop(0), scrollHeight(0) {
         textbgcolor = ST77XX_BLACK;
         textcolor = ST77XX_WHITE;
     }
 
+    virtual ~St7735Matrix() {
+        if (buffer != nullptr) {
+            free(buffer);
+        }
+    }
+
     /*! Start the matrix display
      */
     void begin() {
@@ -47,6 +146,272 @@ class St7735Matrix : public Adafruit_ST7735 {
         setRotation(rotation);
     }
 
+    /*! Enable or disable the frame buffer
+     *
+     * With frame buffer, graphic operations have no immediate effect on the display. Only the
+     * pixels that actually change are collected in a list of dirty rectangles, which is
+     * transmitted by \ref write(). A 160x128 display needs 40 KB of RAM for the frame buffer.
+     *
+     * When the frame buffer is enabled, it is filled with the text background color and the
+     * whole screen is marked dirty.
+     *
+     * @param buffered  `true` to enable the frame buffer, `false` to draw directly to the display
+     * @return          `true` on success, `false` if the frame buffer could not be allocated.
+     */
+    bool setBuffered(bool buffered) {
+        if (buffered && buffer == nullptr) {
+            buffer = (uint16_t *)malloc((size_t)WIDTH * HEIGHT * sizeof(uint16_t));
+            if (buffer == nullptr) {
+                return false;
+            }
+            for (uint32_t i = 0; i < (uint32_t)WIDTH * HEIGHT; i++) {
+                buffer[i] = textbgcolor;
+            }
+            invalidate();
+        } else if (!buffered && buffer != nullptr) {
+            write();
+            free(buffer);
+            buffer = nullptr;
+        }
+        return true;
+    }
+
+    /*! Returns if the display is operated with a frame buffer
+     * @returns `true` if the frame buffer is enabled
+     */
+    inline bool isBuffered() const {
+        return buffer != nullptr;
+    }
+
+    /*! Flushes the frame buffer to the display
+     *
+     * All dirty rectangles collected since the last flush are transmitted in a single SPI
+     * transaction. Without frame buffer this method does nothing.
+     */
+    void write() {
+        if (buffer == nullptr || !dirtyCount) {
+            return;
+        }
+        Adafruit_ST7735::startWrite();
+        for (uint8_t i = 0; i < dirtyCount; i++) {
+            const DirtyRect &r = dirty[i];
+            setAddrWindow(r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0);
+            for (int16_t y = r.y0; y < r.y1; y++) {
+                writePixels(buffer + y * _width + r.x0, r.x1 - r.x0);
+            }
+        }
+        Adafruit_ST7735::endWrite();
+        dirtyCount = 0;
+    }
+
+    /*! Forces the next write to transmit the complete frame buffer
+     */
+    void invalidate() {
+        dirty[0] = {0, 0, _width, _height};
+        dirtyCount = 1;
+    }
+
+    /*! Get the number of dirty rectangles waiting to be transmitted
+     * @returns Number of dirty rectangles
+     */
+    inline uint8_t getDirtyCount() const {
+        return dirtyCount;
+    }
+
+    /*! Define the area scrolled by the hardware vertical scrolling
+     *
+     * The controller scrolls along the long side of the panel, therefore hardware scrolling is
+     * only available in portrait orientation (rotation 0 or 2) of 128x160 and 80x160 panels. The
+     * content of the area is not changed. After the definition the scroll position is 0.
+     *
+     * @param y     Top of the scroll area
+     * @param h     Height of the scroll area in pixel rows
+     * @return      `true` on success, `false` if hardware scrolling is not available
+     */
+    bool setScrollArea(int16_t y, int16_t h) {
+        if ((getRotation() & 1) || hardware == INITR_144GREENTAB || hardware == INITR_HALLOWING ||
+            y < 0 || h <= 0 || y + h > _height) {
+            return false;
+        }
+        scrollTop = y;
+        scrollHeight = h;
+        uint16_t top = getScrollMemoryTop();
+        uint16_t params[3] = {top, (uint16_t)h, (uint16_t)(getMemoryRows() - top - h)};
+        uint8_t data[6];
+        for (uint8_t i = 0; i < 3; i++) {
+            data[i * 2] = params[i] >> 8;
+            data[i * 2 + 1] = params[i] & 0xff;
+        }
+        sendCommand(ST77XX_VSCRDEF, data, sizeof(data));
+        scrollTo(0);
+        return true;
+    }
+
+    /*! Set the hardware scroll position
+     *
+     * Scrolls the content of the scroll area up by `pos` pixel rows. The pixel row that is
+     * displayed at the bottom of the scroll area at position `pos` is located at
+     * \ref getScrollRow() `(pos + height - 1)`.
+     *
+     * @param pos   Scroll position in pixel rows. The position wraps around at the height of the
+     *              scroll area.
+     */
+    void scrollTo(int16_t pos) {
+        if (!scrollHeight) {
+            return;
+        }
+        int16_t offset = pos % scrollHeight;
+        offset = offset < 0 ? offset + scrollHeight : offset;
+        if (getRotation() == 0 && offset) {
+            // rows are mirrored (MY) in rotation 0
+            offset = scrollHeight - offset;
+        }
+        uint16_t start = getScrollMemoryTop() + offset;
+        uint8_t data[2] = {(uint8_t)(start >> 8), (uint8_t)(start & 0xff)};
+        sendCommand(ST77XX_VSCRSADD, data, sizeof(data));
+    }
+
+    /*! Get the display row where a row of the scrolled content is stored
+     *
+     * The content of the scroll area is a ring of pixel rows. Row `n` of the content is visible
+     * at scroll positions `n - height + 1` to `n`. Drawing to the returned row changes the
+     * content row `n` (and all other content rows sharing the same storage).
+     *
+     * @param n     Content row
+     * @return      The Y coordinate for drawing the content row
+     */
+    int16_t getScrollRow(int16_t n) const {
+        if (!scrollHeight) {
+            return n;
+        }
+        int16_t offset = n % scrollHeight;
+        return scrollTop + (offset < 0 ? offset + scrollHeight : offset);
+    }
+
+    /*! Check if hardware scrolling is active
+     * @return `true` if a scroll area is defined
+     */
+    inline bool isScrolling() const {
+        return scrollHeight != 0;
+    }
+
+    /*! Leave the hardware scrolling mode
+     *
+     * The content of the scroll area is displayed as stored in the display RAM, which is usually
+     * not the scrolled order. The caller is responsible to redraw the scroll area.
+     */
+    void endScroll() {
+        if (scrollHeight) {
+            scrollHeight = 0;
+            sendCommand(ST77XX_NORON);
+        }
+    }
+
+    virtual void setRotation(uint8_t m) {
+        // scroll areas are defined in the orientation of the display
+        endScroll();
+        Adafruit_ST7735::setRotation(m);
+        if (buffer != nullptr) {
+            // the frame buffer is kept in the orientation of the display
+            invalidate();
+        }
+    }
+
+    virtual void startWrite(void) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::startWrite();
+        }
+    }
+
+    virtual void endWrite(void) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::endWrite();
+        }
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::drawPixel(x, y, color);
+        } else {
+            storeFill(x, y, 1, 1, color);
+        }
+    }
+
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::writePixel(x, y, color);
+        } else {
+            storeFill(x, y, 1, 1, color);
+        }
+    }
+
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::writeFillRect(x, y, w, h, color);
+        } else {
+            storeFill(x, y, w, h, color);
+        }
+    }
+
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::writeFastHLine(x, y, w, color);
+        } else {
+            storeFill(x, y, w, 1, color);
+        }
+    }
+
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::writeFastVLine(x, y, h, color);
+        } else {
+            storeFill(x, y, 1, h, color);
+        }
+    }
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::fillRect(x, y, w, h, color);
+        } else {
+            storeFill(x, y, w, h, color);
+        }
+    }
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::drawFastHLine(x, y, w, color);
+        } else {
+            storeFill(x, y, w, 1, color);
+        }
+    }
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::drawFastVLine(x, y, h, color);
+        } else {
+            storeFill(x, y, 1, h, color);
+        }
+    }
+
+    using Adafruit_ST7735::drawRGBBitmap;
+
+    /*! Draw a RAM-resident 16-bit image (RGB 5/6/5) at the specified (x,y) position
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param pcolors   Pointer to the 16-bit color array
+     * @param w         Width of the image in pixels
+     * @param h         Height of the image in pixels
+     */
+    void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w, int16_t h) {
+        if (buffer == nullptr) {
+            Adafruit_ST7735::drawRGBBitmap(x, y, pcolors, w, h);
+        } else {
+            for (int16_t row = 0; row < h; row++) {
+                storeSpan(x, y + row, pcolors + row * w, w);
+            }
+        }
+    }
+
     /*! Returns if too long text will be wrapped to the next line
      * @returns Wrapping mode
      */
@@ -117,8 +482,58 @@ class St7735Matrix : public Adafruit_ST7735 {
      *                  box is adjusted to a multiple of this value
      * @return          `true` if the string fits the defined space, `false` if output was truncated
      */
-    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, String content,
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const String &content,
                         uint8_t baseLine, uint8_t yAdvance = 0) {
+        return printFormatted(x, y, w, align, content.c_str(), baseLine, yAdvance);
+    }
+
+    /*! Prints a text at a specified location with a specified formatting
+     *
+     * This method prints a text at the specified location with the specified length using left,
+     * right or centered alignment. All parameters are checked for plasibility and will be adapted
+     * to the current display size.
+     *
+     * The text area including the background is rendered row by row into a small line buffer and
+     * streamed to the display in a single address window, so no canvas has to be allocated and
+     * every pixel is transferred exactly once.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Top left corner y coordinate
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The zero terminated string to print
+     * @param baseLine  The distance between baseline and topline
+     * @param yAdvance  The newline distance - If specified, the height of the calculated bounding
+     *                  box is adjusted to a multiple of this value
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormatted(int16_t x, int16_t y, int16_t w, int16_t align, const char *content,
+                        uint8_t baseLine, uint8_t yAdvance = 0) {
+        return printFormattedRows(x, y, w, align, content, baseLine, yAdvance, 0, -1);
+    }
+
+    /*! Prints some pixel rows of a formatted text
+     *
+     * This method renders only the pixel rows `firstRow` to `firstRow + rows - 1` of the text
+     * area that \ref printFormatted() would draw and places them at the rows starting at `y`.
+     * Rows outside of the text bounds are filled with the background color. This allows to draw
+     * a text progressively, e.g. while it is scrolled into the display.
+     *
+     * @param x         Top left corner x coordinate
+     * @param y         Y coordinate of the first drawn row
+     * @param w         Width in digit positions
+     * @param align     Alignment of the string to display: 0 = left, 1 = center, 2 = right
+     * @param content   The zero terminated string to print
+     * @param baseLine  The distance between baseline and topline
+     * @param yAdvance  The newline distance - If specified, the height of the calculated bounding
+     *                  box is adjusted to a multiple of this value
+     * @param firstRow  The first pixel row of the text area to draw
+     * @param rows      The number of pixel rows to draw. If negative, all rows of the text area
+     *                  starting from `firstRow` are drawn.
+     * @return          `true` if the string fits the defined space, `false` if output was truncated
+     */
+    bool printFormattedRows(int16_t x, int16_t y, int16_t w, int16_t align, const char *content,
+                            uint8_t baseLine, uint8_t yAdvance, int16_t firstRow, int16_t rows) {
         int16_t xx = 0, yy = 0;
         uint16_t ww = 0, hh = 0;
         bool old_wrap = wrap;
@@ -144,20 +559,247 @@ class St7735Matrix : public Adafruit_ST7735 {
         if (yAdvance && (hh % yAdvance)) {
             hh = ((hh / yAdvance) + 1) * yAdvance;
         }
-        GFXcanvas16 tmp(w, hh);
-        if (gfxFont) {
-            tmp.setFont(gfxFont);
+        int16_t by = baseLine ? baseLine : -1 * yy;
+
+        // clip the requested rows against the screen (coordinates relative to the text area)
+        y -= firstRow;
+        int16_t x0 = x < 0 ? -x : 0;
+        int16_t x1 = x + w > _width ? _width - x : w;
+        int16_t y0 = y + firstRow < 0 ? -y : firstRow;
+        int16_t y1 = rows < 0 ? hh : firstRow + rows;
+        y1 = y + y1 > _height ? _height - y : y1;
+        if (x0 < x1 && y0 < y1) {
+            uint16_t line[lineBufferSize];
+            St7735ClassicGlyphs glyphs(_cp437);
+            startWrite();
+            if (buffer == nullptr) {
+                setAddrWindow(x + x0, y + y0, x1 - x0, y1 - y0);
+            }
+            for (int16_t row = y0; row < y1; row++) {
+                for (int16_t col = x0; col < x1; col += lineBufferSize) {
+                    int16_t count = x1 - col > lineBufferSize ? lineBufferSize : x1 - col;
+                    renderSpan(content, xx, by, row, col, line, count, glyphs);
+                    if (buffer == nullptr) {
+                        writePixels(line, count);
+                    } else {
+                        storeSpan(x + col, y + row, line, count);
+                    }
+                }
+            }
+            endWrite();
         }
-        tmp.fillScreen(textbgcolor);
-        tmp.setTextWrap(false);
-        tmp.setCursor(xx, baseLine ? baseLine : -1 * yy);
-        tmp.setTextColor(textcolor, textbgcolor);
-        tmp.print(content);
-        drawRGBBitmap(x, y, tmp.getBuffer(), w, hh);
+
         // set cursor after last printed character
-        setCursor(x + tmp.getCursorX(), y + (baseLine ? baseLine : -1 * yy));
+        int16_t cx = xx, cy = by;
+        for (const unsigned char *pPtr = (const unsigned char *)content; *pPtr; pPtr++) {
+            advanceChar(*pPtr, cx, cy);
+        }
+        setCursor(x + cx, y + by);
         return w >= (int16_t)ww;
     }
+
+    /*! The number of pixels rendered at once by \ref printFormatted() */
+    static const int16_t lineBufferSize = 32;
+
+  protected:
+    uint16_t getMemoryRows() const {
+        // the row offset of the panel is centered in the display RAM of the controller
+        return HEIGHT + 2 * _rowstart;
+    }
+
+    uint16_t getScrollMemoryTop() const {
+        // in rotation 0 the row addresses are mirrored (MY)
+        uint16_t top = scrollTop + _ystart;
+        return getRotation() == 0 ? getMemoryRows() - top - scrollHeight : top;
+    }
+
+    void storeFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        // fills a rectangle of the frame buffer and marks the changed pixels dirty
+        if (w < 0) {
+            x += w + 1;
+            w = -w;
+        }
+        if (h < 0) {
+            y += h + 1;
+            h = -h;
+        }
+        int16_t x0 = x < 0 ? 0 : x;
+        int16_t y0 = y < 0 ? 0 : y;
+        int16_t x1 = x + w > _width ? _width : x + w;
+        int16_t y1 = y + h > _height ? _height : y + h;
+        for (int16_t row = y0; row < y1; row++) {
+            uint16_t *pRow = buffer + row * _width;
+            int16_t first = -1, last = -1;
+            for (int16_t col = x0; col < x1; col++) {
+                if (pRow[col] != color) {
+                    pRow[col] = color;
+                    first = first < 0 ? col : first;
+                    last = col;
+                }
+            }
+            if (first >= 0) {
+                addDirty(first, row, last + 1, row + 1);
+            }
+        }
+    }
+
+    void storeSpan(int16_t x, int16_t y, const uint16_t *colors, int16_t count) {
+        // copies a row of pixels into the frame buffer and marks the changed pixels dirty
+        if (y < 0 || y >= _height) {
+            return;
+        }
+        int16_t x0 = x < 0 ? 0 : x;
+        int16_t x1 = x + count > _width ? _width : x + count;
+        uint16_t *pRow = buffer + y * _width;
+        int16_t first = -1, last = -1;
+        for (int16_t col = x0; col < x1; col++) {
+            uint16_t color = colors[col - x];
+            if (pRow[col] != color) {
+                pRow[col] = color;
+                first = first < 0 ? col : first;
+                last = col;
+            }
+        }
+        if (first >= 0) {
+            addDirty(first, y, last + 1, y + 1);
+        }
+    }
+
+    void addDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        // merge with all rectangles where the union does not waste too many pixels
+        for (uint8_t i = 0; i < dirtyCount;) {
+            DirtyRect &r = dirty[i];
+            int16_t ux0 = min(r.x0, x0), uy0 = min(r.y0, y0);
+            int16_t ux1 = max(r.x1, x1), uy1 = max(r.y1, y1);
+            uint32_t area = (uint32_t)(ux1 - ux0) * (uy1 - uy0);
+            if (area <= rectArea(r) + (uint32_t)(x1 - x0) * (y1 - y0) + mergeSlack) {
+                // continue with the union and check all remaining rectangles again
+                x0 = ux0;
+                y0 = uy0;
+                x1 = ux1;
+                y1 = uy1;
+                dirty[i] = dirty[--dirtyCount];
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+        if (dirtyCount == maxDirtyRects) {
+            // list is full: merge with the rectangle that grows least
+            uint8_t best = 0;
+            uint32_t bestGrowth = 0xffffffff;
+            for (uint8_t i = 0; i < dirtyCount; i++) {
+                const DirtyRect &r = dirty[i];
+                uint32_t growth = (uint32_t)(max(r.x1, x1) - min(r.x0, x0)) *
+                                      (max(r.y1, y1) - min(r.y0, y0)) -
+                                  rectArea(r);
+                if (growth < bestGrowth) {
+                    best = i;
+                    bestGrowth = growth;
+                }
+            }
+            DirtyRect r = dirty[best];
+            dirty[best] = dirty[--dirtyCount];
+            addDirty(min(r.x0, x0), min(r.y0, y0), max(r.x1, x1), max(r.y1, y1));
+            return;
+        }
+        dirty[dirtyCount++] = {x0, y0, x1, y1};
+    }
+
+    static inline uint32_t rectArea(const DirtyRect &r) {
+        return (uint32_t)(r.x1 - r.x0) * (r.y1 - r.y0);
+    }
+
+    void renderSpan(const char *content, int16_t cx, int16_t cy, int16_t row, int16_t col,
+                    uint16_t *line, int16_t count, St7735ClassicGlyphs &glyphs) {
+        // renders `count` pixels of the text row `row` starting at column `col` into `line`
+        for (int16_t i = 0; i < count; i++) {
+            line[i] = textbgcolor;
+        }
+        for (const unsigned char *pPtr = (const unsigned char *)content; *pPtr; pPtr++) {
+            unsigned char c = *pPtr;
+            if (c == '\n' || c == '\r') {
+                advanceChar(c, cx, cy);
+                continue;
+            }
+            if (gfxFont) {
+                uint8_t first = pgm_read_byte(&gfxFont->first);
+                if (c < first || c > (uint8_t)pgm_read_byte(&gfxFont->last)) {
+                    continue;
+                }
+                GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+                uint8_t gw = pgm_read_byte(&glyph->width), gh = pgm_read_byte(&glyph->height);
+                int16_t gx = cx + (int8_t)pgm_read_byte(&glyph->xOffset);
+                int16_t gy = row - cy - (int8_t)pgm_read_byte(&glyph->yOffset);
+                if (gy >= 0 && gy < gh && gx < col + count && gx + gw > col) {
+                    const uint8_t *bitmap =
+                        pgm_read_bitmap_ptr(gfxFont) + pgm_read_word(&glyph->bitmapOffset);
+                    uint16_t bit = gy * gw;
+                    for (uint8_t i = 0; i < gw; i++, bit++) {
+                        int16_t pos = gx + i - col;
+                        if (pos >= 0 && pos < count &&
+                            (pgm_read_byte(&bitmap[bit >> 3]) & (0x80 >> (bit & 7)))) {
+                            line[pos] = textcolor;
+                        }
+                    }
+                }
+            } else {
+                int16_t gy = row - cy;
+                if (gy >= 0 && gy < 8 && cx < col + count && cx + 5 > col) {
+                    const uint8_t *columns = glyphs.get(c);
+                    for (uint8_t i = 0; i < 5; i++) {
+                        int16_t pos = cx + i - col;
+                        if (pos >= 0 && pos < count && (columns[i] & (1 << gy))) {
+                            line[pos] = textcolor;
+                        }
+                    }
+                }
+            }
+            advanceChar(*pPtr, cx, cy);
+        }
+    }
+
+    void advanceChar(unsigned char c, int16_t &cx, int16_t &cy) {
+        // cursor movement of Adafruit_GFX::write() at text size 1 without wrapping
+        if (c == '\n') {
+            cx = 0;
+            cy += gfxFont ? (uint8_t)pgm_read_byte(&gfxFont->yAdvance) : 8;
+        } else if (c == '\r') {
+            return;
+        } else if (!gfxFont) {
+            cx += 6;
+        } else {
+            uint8_t first = pgm_read_byte(&gfxFont->first);
+            if (c >= first && c <= (uint8_t)pgm_read_byte(&gfxFont->last)) {
+                GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+                cx += (uint8_t)pgm_read_byte(&glyph->xAdvance);
+            }
+        }
+    }
+
+    static GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint8_t c) {
+#ifdef __AVR__
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+        return &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[c]);
+#else
+        return &(((GFXglyph *)pgm_read_word(&gfxFont->glyph))[c]);
+#endif
+#else
+        return gfxFont->glyph + c;
+#endif  //__AVR__
+    }
+
+    static const uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
+#ifdef __AVR__
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+        return (const uint8_t *)pgm_read_dword(&gfxFont->bitmap);
+#else
+        return (const uint8_t *)pgm_read_word(&gfxFont->bitmap);
+#endif
+#else
+        return gfxFont->bitmap;
+#endif  //__AVR__
+    }
 };
 
 }  // namespace ustd
\ No newline at end of file
@@ -0,0 +1,360 @@
+// indexed_canvas.h - palette based off screen canvas with 4 or 8 bits per pixel
+
+#pragma once
+
+#include "Adafruit_GFX.h"
+
+namespace ustd {
+
+/*! \brief Palette based Canvas
+ *
+ * This class implements an off screen canvas for Adafruit GFX that stores a palette index with 4
+ * or 8 bits per pixel instead of a RGB565 value. A 160x128 canvas needs 10 KB with 16 colors or
+ * 20 KB with 256 colors instead of 40 KB, which makes double buffering feasible on small
+ * controllers like the ESP8266.
+ *
+ * The canvas accepts RGB565 colors like all Adafruit GFX classes. Each color is looked up in the
+ * palette and added if it is not yet registered. If the palette is full, the nearest registered
+ * color is used. Colors can be registered in advance with \ref addColor() in order to reserve
+ * palette entries for them (e.g. the colors of a theme).
+ *
+ * Since the pixels only reference palette entries, changing a palette entry with
+ * \ref setPaletteColor() recolors all pixels drawn with that entry without redrawing them. The
+ * palette is expanded to RGB565 while the canvas is transmitted to the display by
+ * \ref drawTo().
+ */
+class IndexedCanvas : public Adafruit_GFX {
+  public:
+    /*! The number of pixels expanded at once by \ref drawTo() */
+    static const int16_t lineBufferSize = 32;
+
+  protected:
+    uint8_t bits;
+    uint16_t stride;
+    uint8_t *buffer;
+    uint16_t *palette;
+    uint16_t colorCount;
+    // cache of the last color lookup
+    uint16_t lastColor;
+    uint8_t lastIndex;
+    bool lastValid;
+
+  public:
+    /*! Instantiates an IndexedCanvas
+     *
+     * Check \ref getBuffer() for `nullptr` to detect if the memory could not be allocated.
+     *
+     * @param w     Width of the canvas in pixels
+     * @param h     Height of the canvas in pixels
+     * @param bits  Bits per pixel: 4 (16 colors) or 8 (256 colors). Default is 4.
+     */
+    IndexedCanvas(uint16_t w, uint16_t h, uint8_t bits = 4)
+        : Adafruit_GFX(w, h), bits(bits == 8 ? 8 : 4), colorCount(0), lastValid(false) {
+        stride = ((uint32_t)w * this->bits + 7) / 8;
+        palette = (uint16_t *)malloc(getPaletteSize() * sizeof(uint16_t));
+        buffer = (uint8_t *)malloc((size_t)stride * h);
+        if (palette == nullptr || buffer == nullptr) {
+            free(palette);
+            free(buffer);
+            palette = nullptr;
+            buffer = nullptr;
+            return;
+        }
+        memset(palette, 0, getPaletteSize() * sizeof(uint16_t));
+        memset(buffer, 0, (size_t)stride * h);
+    }
+
+    virtual ~IndexedCanvas() {
+        if (buffer != nullptr) {
+            free(buffer);
+            free(palette);
+        }
+    }
+
+    /*! Get the pixel buffer
+     * @return Pointer to the palette indices or `nullptr` if the canvas could not be allocated
+     */
+    uint8_t *getBuffer() const {
+        return buffer;
+    }
+
+    /*! Get the number of bits per pixel
+     * @return 4 or 8
+     */
+    inline uint8_t getBits() const {
+        return bits;
+    }
+
+    /*! Get the size of the palette
+     * @return 16 or 256
+     */
+    inline uint16_t getPaletteSize() const {
+        return 1 << bits;
+    }
+
+    /*! Get the number of registered colors
+     * @return The number of used palette entries
+     */
+    inline uint16_t getColorCount() const {
+        return colorCount;
+    }
+
+    /*! Remove all colors from the palette
+     *
+     * The content of the canvas is not changed. All pixels keep referencing their palette entries
+     * which are reused by the next registered colors.
+     */
+    void clearPalette() {
+        colorCount = 0;
+        lastValid = false;
+    }
+
+    /*! Register a color in the palette
+     * @param color     RGB565 color value
+     * @return          The palette index of the color or -1 if the palette is full
+     */
+    int16_t addColor(uint16_t color) {
+        int16_t index = findColor(color);
+        if (index < 0 && colorCount < getPaletteSize() && palette != nullptr) {
+            index = colorCount++;
+            palette[index] = color;
+        }
+        return index;
+    }
+
+    /*! Look up the palette index of a color
+     * @param color     RGB565 color value
+     * @return          The palette index of the color or -1 if the color is not registered
+     */
+    int16_t findColor(uint16_t color) const {
+        for (uint16_t i = 0; i < colorCount; i++) {
+            if (palette[i] == color) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /*! Get the palette index used for drawing a color
+     *
+     * The color is registered if it is not yet in the palette. If the palette is full, the index
+     * of the nearest registered color is returned.
+     *
+     * @param color     RGB565 color value
+     * @return          The palette index
+     */
+    uint8_t colorIndex(uint16_t color) {
+        if (lastValid && lastColor == color) {
+            return lastIndex;
+        }
+        int16_t index = addColor(color);
+        lastColor = color;
+        lastIndex = index < 0 ? nearestColor(color) : index;
+        lastValid = true;
+        return lastIndex;
+    }
+
+    /*! Change the color of a palette entry
+     *
+     * All pixels drawn with this palette entry change their color with the next \ref drawTo().
+     *
+     * @param index     Palette index. If the index is beyond the registered colors, the colors
+     *                  in between are registered as black.
+     * @param color     New RGB565 color value
+     */
+    void setPaletteColor(uint8_t index, uint16_t color) {
+        if (palette == nullptr || index >= getPaletteSize()) {
+            return;
+        }
+        while (colorCount <= index) {
+            palette[colorCount++] = 0;
+        }
+        palette[index] = color;
+        lastValid = false;
+    }
+
+    /*! Get the color of a palette entry
+     * @param index     Palette index
+     * @return          RGB565 color value
+     */
+    uint16_t getPaletteColor(uint8_t index) const {
+        return palette != nullptr && index < getPaletteSize() ? palette[index] : 0;
+    }
+
+    /*! Get the palette index of a pixel
+     * @param x     X coordinate
+     * @param y     Y coordinate
+     * @return      The palette index of the pixel (0 if outside of the canvas)
+     */
+    uint8_t getPixelIndex(int16_t x, int16_t y) const {
+        if (buffer == nullptr || !transform(x, y)) {
+            return 0;
+        }
+        return readIndex(x, y);
+    }
+
+    /*! Get the color of a pixel
+     * @param x     X coordinate
+     * @param y     Y coordinate
+     * @return      The RGB565 color value of the pixel
+     */
+    uint16_t getPixel(int16_t x, int16_t y) const {
+        return getPaletteColor(getPixelIndex(x, y));
+    }
+
+    /*! Transmit the canvas to a display
+     *
+     * The palette indices are expanded to RGB565 in chunks of \ref lineBufferSize pixels and sent
+     * in a single address window. The target must provide the Adafruit SPITFT interface
+     * (`startWrite()`, `setAddrWindow()`, `writePixels()` and `endWrite()`), e.g.
+     * `Adafruit_ST7735` or `Adafruit_ST7789`.
+     *
+     * @param pDisplay  Pointer to the display object
+     * @param x         X coordinate of the top left corner on the display
+     * @param y         Y coordinate of the top left corner on the display
+     */
+    template <class TFT> void drawTo(TFT *pDisplay, int16_t x = 0, int16_t y = 0) {
+        if (buffer == nullptr) {
+            return;
+        }
+        uint16_t line[lineBufferSize];
+        pDisplay->startWrite();
+        pDisplay->setAddrWindow(x, y, WIDTH, HEIGHT);
+        for (int16_t row = 0; row < HEIGHT; row++) {
+            for (int16_t col = 0; col < WIDTH; col += lineBufferSize) {
+                int16_t count = WIDTH - col > lineBufferSize ? lineBufferSize : WIDTH - col;
+                expand(col, row, line, count);
+                pDisplay->writePixels(line, count);
+            }
+        }
+        pDisplay->endWrite();
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (buffer != nullptr && transform(x, y)) {
+            writeIndex(x, y, colorIndex(color));
+        }
+    }
+
+    virtual void fillScreen(uint16_t color) {
+        if (buffer != nullptr) {
+            uint8_t index = colorIndex(color);
+            memset(buffer, bits == 8 ? index : index | (index << 4), (size_t)stride * HEIGHT);
+        }
+    }
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (buffer == nullptr) {
+            return;
+        }
+        if (w < 0) {
+            x += w + 1;
+            w = -w;
+        }
+        if (h < 0) {
+            y += h + 1;
+            h = -h;
+        }
+        int16_t x0 = x < 0 ? 0 : x;
+        int16_t y0 = y < 0 ? 0 : y;
+        int16_t x1 = x + w > _width ? _width : x + w;
+        int16_t y1 = y + h > _height ? _height : y + h;
+        if (x0 >= x1 || y0 >= y1) {
+            return;
+        }
+        uint8_t index = colorIndex(color);
+        for (int16_t row = y0; row < y1; row++) {
+            for (int16_t col = x0; col < x1; col++) {
+                int16_t px = col, py = row;
+                transform(px, py);
+                writeIndex(px, py, index);
+            }
+        }
+    }
+
+  protected:
+    bool transform(int16_t &x, int16_t &y) const {
+        // converts logical coordinates into buffer coordinates
+        if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+            return false;
+        }
+        int16_t t;
+        switch (rotation) {
+        case 1:
+            t = x;
+            x = WIDTH - 1 - y;
+            y = t;
+            break;
+        case 2:
+            x = WIDTH - 1 - x;
+            y = HEIGHT - 1 - y;
+            break;
+        case 3:
+            t = x;
+            x = y;
+            y = HEIGHT - 1 - t;
+            break;
+        }
+        return true;
+    }
+
+    inline uint8_t readIndex(int16_t x, int16_t y) const {
+        if (bits == 8) {
+            return buffer[y * stride + x];
+        }
+        uint8_t value = buffer[y * stride + x / 2];
+        return x & 1 ? value & 0x0f : value >> 4;
+    }
+
+    inline void writeIndex(int16_t x, int16_t y, uint8_t index) {
+        if (bits == 8) {
+            buffer[y * stride + x] = index;
+        } else {
+            uint8_t &value = buffer[y * stride + x / 2];
+            value = x & 1 ? (value & 0xf0) | (index & 0x0f) : (value & 0x0f) | (index << 4);
+        }
+    }
+
+    void expand(int16_t x, int16_t y, uint16_t *line, int16_t count) const {
+        // converts a span of a buffer row into RGB565 using the palette as lookup table
+        const uint8_t *pSrc = buffer + y * stride;
+        if (bits == 8) {
+            for (int16_t i = 0; i < count; i++) {
+                line[i] = palette[pSrc[x + i]];
+            }
+        } else {
+            for (int16_t i = 0; i < count; i++, x++) {
+                uint8_t value = pSrc[x / 2];
+                line[i] = palette[x & 1 ? value & 0x0f : value >> 4];
+            }
+        }
+    }
+
+    uint8_t nearestColor(uint16_t color) const {
+        // squared distance in 5/6/5 component space with green scaled to 5 bits
+        int16_t r = color >> 11, g = (color >> 6) & 0x1f, b = color & 0x1f;
+        uint8_t best = 0;
+        uint16_t bestDistance = 0xffff;
+        for (uint16_t i = 0; i < colorCount; i++) {
+            int16_t dr = r - (palette[i] >> 11);
+            int16_t dg = g - ((palette[i] >> 6) & 0x1f);
+            int16_t db = b - (palette[i] & 0x1f);
+            uint16_t distance = dr * dr + dg * dg + db * db;
+            if (distance < bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+        return best;
+    }
+};
+
+}  // namespace ustd
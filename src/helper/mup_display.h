@@ -35,10 +35,68 @@ class MuppletDisplay {
         Center,   ///< Static centered text
         Right,    ///< Static right formatted text
         SlideIn,  ///< Text slides in char by char to the left side
+        Marquee,  ///< Text scrolls through the display from right to left
+        Scroll,   ///< Text scrolls in from the bottom pushing previous scroll items up
     };
 #endif
 
+    /// Display command resolved by the dispatch table
+    enum Command {
+        CmdClear,
+        CmdPrint,
+        CmdPrintln,
+        CmdPrintAt,
+        CmdFormat,
+        CursorGet,
+        CursorSet,
+        CursorXGet,
+        CursorXSet,
+        CursorYGet,
+        CursorYSet,
+        WrapGet,
+        WrapSet,
+        ColorGet,
+        ColorSet,
+        BackgroundGet,
+        BackgroundSet,
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        CountGet,
+        DefaultGet,
+        DefaultSet,
+        DefaultModeGet,
+        DefaultModeSet,
+        DefaultRepeatGet,
+        DefaultRepeatSet,
+        DefaultDurationGet,
+        DefaultDurationSet,
+        DefaultSpeedGet,
+        DefaultSpeedSet,
+        DefaultFontGet,
+        DefaultFontSet,
+        DefaultColorGet,
+        DefaultColorSet,
+        DefaultBackgroundGet,
+        DefaultBackgroundSet,
+        ItemsClear,
+        ItemsGet,
+        ItemsAdd,
+        ContentClear,
+        ContentGet,
+        ContentAdd,
+#endif
+        CommandCount  ///< Number of commands
+    };
+
   protected:
+    // entry of a command dispatch table - tables are sorted by path
+    typedef struct {
+        const char *path;
+        uint8_t command;
+    } CommandEntry;
+
+    static const CommandEntry commandTable[];
+    static const uint8_t commandTableSize;
+
     // font helper
     typedef struct {
         uint8_t baseLine;
@@ -89,12 +147,13 @@ class MuppletDisplay {
     uint8_t program_height;
     unsigned long anonymous_counter;
     // runtime - effect control
-    uint8_t delayCtr;   // effect delay counter
-    uint16_t charPos;   // index of char to slide
-    uint16_t lastPos;   // target position of sliding char
-    uint16_t slidePos;  // position of sliding char
-    uint8_t charX;      // width of current char
-    uint8_t charY;      // height of current char
+    uint8_t delayCtr;    // effect delay counter
+    uint16_t charPos;    // index of char to slide
+    uint16_t lastPos;    // target position of sliding char
+    uint16_t slidePos;   // position of sliding char
+    uint8_t charX;       // width of current char
+    uint8_t charY;       // height of current char
+    int16_t marqueePos;  // scroll position of the marquee or the vertical scroll
 #endif
 
   public:
@@ -117,6 +176,8 @@ class MuppletDisplay {
     void setPlayer(int16_t posY = -1, uint8_t height = 0) {
         int16_t w, h;
         getDimensions(w, h);
+        // the scroll area depends on the player area
+        scrollEnd();
         if (posY < 0 || height == 0) {
             // player will be disabled - clear player area before disabling
             displayClear(0, program_pos, w, program_height);
@@ -159,6 +220,9 @@ class MuppletDisplay {
     /*! Remove all program items
      */
     void clearItems() {
+        if (program_state != None && program[program_counter].mode == Marquee) {
+            marqueeEnd();
+        }
         program.erase();
         program_counter = 0;
         program_state = None;
@@ -191,6 +255,10 @@ class MuppletDisplay {
         if (program.length() == 0 || program_height == 0 || program_pos < 0) {
             return;
         }
+        if (!displayReady()) {
+            // pace the program player on the completion of the previous frame
+            return;
+        }
         // save state
         int16_t x, y, w, h;
         bool cur_wrap = getTextWrap();
@@ -216,6 +284,7 @@ class MuppletDisplay {
             endProgramItem(program[program_counter], x, y, w, h);
         }
         if (program.length() == 0) {
+            scrollEnd();
             displayClear(0, program_pos, program_width, program_height);
         }
 
@@ -227,36 +296,66 @@ class MuppletDisplay {
     }
 #endif
 
-    virtual bool commandParser(String command, String args, String topic) {
-        if (command.startsWith("cmnd/")) {
-            return commandCmdParser(command.substring(5), args);
-        } else if (command.startsWith("cursor/")) {
-            return cursorParser(command.substring(7), args, topic + "/cursor");
-        } else if (command.startsWith("wrap/")) {
-            return wrapParser(command.substring(5), args, topic + "/wrap");
-        } else if (command.startsWith("color/")) {
-            return colorParser(command.substring(6), args, topic + "/color", true);
-        } else if (command.startsWith("background/")) {
-            return colorParser(command.substring(11), args, topic + "/background", false);
+    static int16_t findCommand(const CommandEntry *table, uint8_t count, const char *command) {
+        // binary search in a dispatch table sorted by path
+        uint8_t lo = 0;
+        uint8_t hi = count;
+        while (lo < hi) {
+            uint8_t mid = (lo + hi) / 2;
+            int cmp = strcmp(command, table[mid].path);
+            if (cmp == 0) {
+                return table[mid].command;
+            } else if (cmp < 0) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return -1;
+    }
+
+    virtual bool commandParser(const char *command, String &args) {
+        int16_t cmd = findCommand(commandTable, commandTableSize, command);
+        if (cmd >= 0) {
+            return commandDispatcher(cmd, args);
 #ifdef USTD_FEATURE_PROGRAMPLAYER
-        } else if (command == "count/get") {
+        } else if (!strncmp(command, "items/", 6)) {
+            return commandItemsParser(command + 6, args, false);
+        } else if (!strncmp(command, "content/", 8)) {
+            return commandItemsParser(command + 8, args, true);
+#endif
+        }
+        return false;
+    }
+
+    bool commandDispatcher(int16_t command, String &args) {
+        if (command <= CmdFormat) {
+            return commandCmdParser(command, args);
+        } else if (command <= CursorYSet) {
+            return cursorParser(command, args);
+        } else if (command <= WrapSet) {
+            return wrapParser(command == WrapSet, args);
+        } else if (command <= ColorSet) {
+            return colorParser(command == ColorSet, args, true);
+        } else if (command <= BackgroundSet) {
+            return colorParser(command == BackgroundSet, args, false);
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+        } else if (command == CountGet) {
             return publishItemsCount();
-        } else if (command.startsWith("default/")) {
-            return commandDefaultParser(command.substring(8), args, topic + "/default");
-        } else if (command.startsWith("items/")) {
-            return commandItemsParser(command.substring(6), args, topic + "/items");
-        } else if (command.startsWith("content/")) {
-            return commandContentParser(command.substring(8), args, topic + "/content");
+        } else if (command <= DefaultBackgroundSet) {
+            return commandDefaultParser(command, args);
+        } else if (command <= ContentAdd) {
+            return commandProgramParser(command, args);
 #endif
         }
         return false;
     }
 
-    virtual bool commandCmdParser(String command, String args) {
+    virtual bool commandCmdParser(int16_t command, String &args) {
         int16_t x, y, w, h, d, width, height;
         FontSize fs;
         array<String> params;
-        if (command == "clear") {
+        if (command == CmdClear) {
             if (args.length()) {
                 split(args, ';', params);
             }
@@ -291,20 +390,20 @@ class MuppletDisplay {
                 setCursor(x, y + fs.baseLine);
                 return true;
             }
-        } else if (command == "print") {
+        } else if (command == CmdPrint) {
             displayPrint(args);
             return true;
-        } else if (command == "println") {
+        } else if (command == CmdPrintln) {
             displayPrint(args, true);
             return true;
-        } else if (command == "printat") {
+        } else if (command == CmdPrintAt) {
             getDimensions(width, height);
             x = parseRangedLong(shift(args, ';', "0"), 0, width - 1, 0, width - 1);
             y = parseRangedLong(shift(args, ';', "0"), 0, height - 1, 0, height - 1);
             setCursor(x, y);
             displayPrint(args);
             return true;
-        } else if (command == "format") {
+        } else if (command == CmdFormat) {
             getDimensions(width, height);
             x = parseLong(shift(args, ';', ""), 0);
             y = parseLong(shift(args, ';', ""), 0);
@@ -322,8 +421,8 @@ class MuppletDisplay {
                     // not a Number
                     displayError(x, y, w, 2);
                 } else {
-                    args = String(atof(args.c_str()), d);
-                    if (!displayFormat(x, y, w, 2, args, current_font, current_fg, current_bg)) {
+                    int32_t value;
+                    if (!parseFixed(args.c_str(), d, value) || !displayNumber(x, y, w, value, d)) {
                         // overflow
                         displayError(x, y, w, 2);
                     }
@@ -338,34 +437,37 @@ class MuppletDisplay {
         return false;
     }
 
-    bool cursorParser(String command, String args, String topic) {
+    bool cursorParser(int16_t command, String &args) {
         int16_t x, y, width, height;
-        if (command == "get") {
+        String topic = name + "/display/cursor";
+        if (command == CursorGet) {
             getCursor(x, y);
             pSched->publish(topic, String(x) + ";" + String(y));
             return true;
-        } else if (command == "set") {
+        } else if (command == CursorSet) {
             getDimensions(width, height);
-            setCursor(parseRangedLong(shift(args, ';'), 0, width - 1, 0, width - 1),
-                      parseRangedLong(shift(args, ';'), 0, height - 1, 0, height - 1));
+            x = parseRangedLong(shift(args, ';'), 0, width - 1, 0, width - 1);
+            y = parseRangedLong(shift(args, ';'), 0, height - 1, 0, height - 1);
+            setCursor(x, y);
             getCursor(x, y);
             pSched->publish(topic, String(x) + ";" + String(y));
             return true;
-        } else if (command == "x/get") {
+        } else if (command == CursorXGet) {
             getCursor(x, y);
             pSched->publish(topic + "/x", String(x));
             return true;
-        } else if (command == "x/set") {
+        } else if (command == CursorXSet) {
             getCursor(x, y);
             getDimensions(width, height);
             setCursor(parseRangedLong(shift(args, ';'), 0, width - 1, 0, width - 1), y);
             getCursor(x, y);
             pSched->publish(topic + "/x", String(x));
             return true;
-        } else if (command == "y/get") {
+        } else if (command == CursorYGet) {
             getCursor(x, y);
             pSched->publish(topic + "/y", String(y));
-        } else if (command == "y/set") {
+            return true;
+        } else if (command == CursorYSet) {
             getCursor(x, y);
             getDimensions(width, height);
             setCursor(x, parseRangedLong(shift(args, ';'), 0, height - 1, 0, height - 1));
@@ -376,54 +478,34 @@ class MuppletDisplay {
         return false;
     }
 
-    bool wrapParser(String command, String args, String topic) {
-        if (command == "get") {
-            pSched->publish(topic, getTextWrap() ? "on" : "off");
-            return true;
-        } else if (command == "set") {
+    bool wrapParser(bool set, String &args) {
+        if (set) {
             int8_t wrap = parseBoolean(args);
-            if (wrap >= 0) {
-                setTextWrap(wrap == 1);
-                pSched->publish(topic, getTextWrap() ? "on" : "off");
-                return true;
+            if (wrap < 0) {
+                return false;
             }
+            setTextWrap(wrap == 1);
         }
-        return false;
+        pSched->publish(name + "/display/wrap", getTextWrap() ? "on" : "off");
+        return true;
     }
 
-    bool colorParser(String command, String args, String topic, bool fg) {
-        if (features & MUPDISP_FEATURE_MONO) {
-            if (command == "get") {
-                pSched->publish(topic, (fg ? current_fg : current_bg) ? "0x1" : "0x0");
-                return true;
-            } else if (command == "set") {
-                if (fg) {
-                    current_fg = parseColor(args, current_fg) ? 1 : 0;
-                    setTextColor(current_fg, current_bg);
-                    pSched->publish(topic, current_fg ? "0x1" : "0x0");
-                } else {
-                    current_bg = parseColor(args, current_bg) ? 1 : 0;
-                    setTextColor(current_fg, current_bg);
-                    pSched->publish(topic, current_bg ? "0x1" : "0x0");
-                }
-            }
-        } else if (features & MUPDISP_FEATURE_COLOR) {
-            if (command == "get") {
-                pSched->publish(topic, "0x" + String(fg ? current_fg : current_bg, HEX));
-                return true;
-            } else if (command == "set") {
-                if (fg) {
-                    current_fg = parseColor(args, current_fg);
-                    setTextColor(current_fg, current_bg);
-                    pSched->publish(topic, "0x" + String(current_fg, HEX));
-                } else {
-                    current_bg = parseColor(args, current_bg);
-                    setTextColor(current_fg, current_bg);
-                    pSched->publish(topic, "0x" + String(current_bg, HEX));
-                }
+    bool colorParser(bool set, String &args, bool fg) {
+        uint16_t &color = fg ? current_fg : current_bg;
+        if (set) {
+            color = parseColor(args, color);
+            if (features & MUPDISP_FEATURE_MONO) {
+                color = color ? 1 : 0;
             }
+            setTextColor(current_fg, current_bg);
         }
-        return false;
+        String topic = name + (fg ? "/display/color" : "/display/background");
+        if (features & MUPDISP_FEATURE_MONO) {
+            pSched->publish(topic, color ? "0x1" : "0x0");
+        } else {
+            pSched->publish(topic, "0x" + String(color, HEX));
+        }
+        return true;
     }
 
     uint16_t parseColor(String &args, uint16_t defaultVal) {
@@ -474,142 +556,96 @@ class MuppletDisplay {
     }
 
 #ifdef USTD_FEATURE_PROGRAMPLAYER
-    bool commandDefaultParser(String command, String args, String topic) {
-        if (command == "get") {
+    bool commandDefaultParser(int16_t command, String &args) {
+        String topic = name + "/display/default";
+        switch (command) {
+        case DefaultGet:
             return publishDefaults(topic);
-        } else if (command == "set") {
-            if (parseDefaults(args)) {
-                return publishDefaults(topic);
-            }
-        } else if (command == "mode/get") {
-            return publishDefaultMode(topic + "/mode");
-        } else if (command == "mode/set") {
-            if (parseMode(args, default_item)) {
-                return publishDefaultMode(topic + "/mode");
-            }
-        } else if (command == "repeat/get") {
-            return publishDefaultRepeat(topic + "/repeat");
-        } else if (command == "repeat/set") {
-            if (parseRepeat(args, default_item)) {
-                return publishDefaultRepeat(topic + "/repeat");
-            }
-        } else if (command == "duration/get") {
-            return publishDefaultDuration(topic + "/duration");
-        } else if (command == "duration/set") {
-            if (parseDuration(args, default_item)) {
-                return publishDefaultDuration(topic + "/duration");
-            }
-        } else if (command == "speed/get") {
-            return publishDefaultSpeed(topic + "/speed");
-        } else if (command == "speed/set") {
-            if (parseSpeed(args, default_item)) {
-                return publishDefaultSpeed(topic + "/speed");
-            }
-        } else if (command == "font/get") {
-            return publishDefaultFont(topic + "/font");
-        } else if (command == "font/set") {
-            if (parseFont(args, default_item)) {
-                return publishDefaultFont(topic + "/font");
-            }
-        } else if (command == "color/get") {
-            return publishDefaultColor(topic + "/color");
-        } else if (command == "color/set") {
-            if (parseColor(args, default_item)) {
-                return publishDefaultColor(topic + "/Color");
-            }
-        } else if (command == "background/get") {
-            return publishDefaultBackground(topic + "/background");
-        } else if (command == "background/set") {
-            if (parseBackground(args, default_item)) {
-                return publishDefaultBackground(topic + "/background");
-            }
+        case DefaultSet:
+            return parseDefaults(args) && publishDefaults(topic);
+        case DefaultModeGet:
+            return publishDefaultMode(topic);
+        case DefaultModeSet:
+            return parseMode(args, default_item) && publishDefaultMode(topic);
+        case DefaultRepeatGet:
+            return publishDefaultRepeat(topic);
+        case DefaultRepeatSet:
+            return parseRepeat(args, default_item) && publishDefaultRepeat(topic);
+        case DefaultDurationGet:
+            return publishDefaultDuration(topic);
+        case DefaultDurationSet:
+            return parseDuration(args, default_item) && publishDefaultDuration(topic);
+        case DefaultSpeedGet:
+            return publishDefaultSpeed(topic);
+        case DefaultSpeedSet:
+            return parseSpeed(args, default_item) && publishDefaultSpeed(topic);
+        case DefaultFontGet:
+            return publishDefaultFont(topic);
+        case DefaultFontSet:
+            return parseFont(args, default_item) && publishDefaultFont(topic);
+        case DefaultColorGet:
+            return publishDefaultColor(topic);
+        case DefaultColorSet:
+            return parseColor(args, default_item) && publishDefaultColor(topic);
+        case DefaultBackgroundGet:
+            return publishDefaultBackground(topic);
+        case DefaultBackgroundSet:
+            return parseBackground(args, default_item) && publishDefaultBackground(topic);
         }
         return false;
     }
 
-    bool commandItemsParser(String command, String args, String topic) {
-        String name, operation;
-        if (command == "clear") {
+    bool commandProgramParser(int16_t command, String &args) {
+        switch (command) {
+        case ItemsClear:
+        case ContentClear:
             clearItems();
             return publishItemsCount();
-        } else if (command == "get") {
-            return publishItems(topic);
-        } else if (command == "add") {
+        case ItemsGet:
+            return publishItems(name + "/display/items");
+        case ContentGet:
+            return publishContents(name + "/display/content");
+        case ItemsAdd:
             addItem("unnamed_" + String(++anonymous_counter), args);
             return publishItemsCount();
-        } else if (parseItemCommand(command, name, operation)) {
-            int16_t index = findItemByName(name.c_str());
-            if (operation == "set") {
-                if (index < 0) {
-                    index = addItem(name, args);
-                } else {
-                    index = replaceItem(index, args);
-                }
-                if (index >= 0) {
-                    return publishItem(topic, index);
-                }
-            } else if (operation == "get") {
-                return publishItem(topic, index);
-            } else if (operation == "jump") {
-                if (jumpItem(index)) {
-                    return publishItem(topic, index);
-                }
-            } else if (operation == "clear") {
-                if (clearItem(index)) {
-                    return publishItemsCount();
-                }
-            }
-        }
-        return false;
-    }
-
-    bool commandContentParser(String command, String args, String topic) {
-        String name, operation;
-        if (command == "clear") {
-            clearItems();
-            return publishItemsCount();
-        } else if (command == "get") {
-            return publishContents(topic);
-        } else if (command == "add") {
+        case ContentAdd:
             addContent("unnamed_" + String(++anonymous_counter), args);
             return publishItemsCount();
-        } else if (parseItemCommand(command, name, operation)) {
-            int16_t index = findItemByName(name.c_str());
-            if (operation == "set") {
-                if (index < 0) {
-                    index = addContent(name, args);
-                } else {
-                    index = replaceContent(index, args);
-                }
-                if (index >= 0) {
-                    return publishContent(topic, index);
-                }
-            } else if (operation == "get") {
-                return publishContent(topic, index);
-            } else if (operation == "jump") {
-                if (jumpItem(index)) {
-                    return publishContent(topic, index);
-                }
-            } else if (operation == "clear") {
-                if (clearItem(index)) {
-                    return publishItemsCount();
-                }
-            }
         }
         return false;
     }
 
-    bool parseItemCommand(String command, String &name, String &operation) {
-        const char *pPtr = command.c_str();
-        const char *pOperation = strrchr(pPtr, '/');
-        if (!pOperation) {
+    bool commandItemsParser(const char *command, String &args, bool content) {
+        // command format: <item name>/<operation>
+        const char *pOperation = strrchr(command, '/');
+        if (!pOperation || pOperation == command || !pOperation[1]) {
             return false;
         }
-        size_t len = pOperation - pPtr;
-        operation = pOperation + 1;
-        name = pPtr;
-        name.remove(len);
-        return name.length() && operation.length();
+        size_t len = pOperation - command;
+        int16_t index = findItemByName(command, len);
+        String topic = name + (content ? "/display/content" : "/display/items");
+        ++pOperation;
+        if (!strcmp(pOperation, "set")) {
+            if (index < 0) {
+                String itemName = command;
+                itemName.remove(len);
+                index = content ? addContent(itemName, args) : addItem(itemName, args);
+            } else {
+                index = content ? replaceContent(index, args) : replaceItem(index, args);
+            }
+            if (index < 0) {
+                return false;
+            }
+        } else if (!strcmp(pOperation, "clear")) {
+            return clearItem(index) && publishItemsCount();
+        } else if (!strcmp(pOperation, "jump")) {
+            if (!jumpItem(index)) {
+                return false;
+            }
+        } else if (strcmp(pOperation, "get")) {
+            return false;
+        }
+        return content ? publishContent(topic, index) : publishItem(topic, index);
     }
 
     bool publishItemsCount() {
@@ -795,6 +831,7 @@ class MuppletDisplay {
             }
         }
         if (program.length() == 0) {
+            scrollEnd();
             displayClear(0, program_pos, program_width, program_height);
         }
         return true;
@@ -819,8 +856,7 @@ class MuppletDisplay {
         ProgramItem item = default_item;
         item.name = name;
         item.content = args;
-        program.add(item);
-        return program.length();
+        return program.add(item);
     }
 
     int16_t replaceContent(int16_t i, String args) {
@@ -849,9 +885,9 @@ class MuppletDisplay {
         return true;
     }
 
-    int16_t findItemByName(const char *name) {
+    int16_t findItemByName(const char *name, size_t len) {
         for (int16_t i = 0; i < (int16_t)program.length(); i++) {
-            if (program[i].name == name) {
+            if (program[i].name.length() == len && !strncmp(program[i].name.c_str(), name, len)) {
                 return i;
             }
         }
@@ -902,6 +938,50 @@ class MuppletDisplay {
         return true;
     }
 
+    bool parseFixed(const char *value, uint8_t decimals, int32_t &result) {
+        // converts a number validated by isNumber() into a fixed point value with the specified
+        // number of decimals - rounds half away from zero like String(double, decimals)
+        if (decimals > 9) {
+            return false;
+        }
+        bool negative = *value == '-';
+        if (negative) {
+            value++;
+        }
+        int32_t fixed = 0;
+        bool point = false;
+        bool roundUp = false;
+        uint8_t fraction = 0;
+        for (; *value; value++) {
+            if (*value == '.') {
+                point = true;
+            } else if (point && fraction == decimals) {
+                // first digit that is not displayed anymore
+                roundUp = *value >= '5';
+                break;
+            } else if (fixed > (0x7fffffff - (*value - '0')) / 10) {
+                return false;
+            } else {
+                fixed = fixed * 10 + (*value - '0');
+                fraction += point ? 1 : 0;
+            }
+        }
+        for (; fraction < decimals; fraction++) {
+            if (fixed > 0x7fffffff / 10) {
+                return false;
+            }
+            fixed *= 10;
+        }
+        if (roundUp) {
+            if (fixed == 0x7fffffff) {
+                return false;
+            }
+            fixed++;
+        }
+        result = negative ? -fixed : fixed;
+        return true;
+    }
+
     void displayError(int16_t x, int16_t y, int16_t w, int16_t align) {
         if (w >= 5) {
             displayFormat(x, y, w, align, "Error", current_font, current_fg, current_bg);
@@ -928,6 +1008,32 @@ class MuppletDisplay {
     virtual bool displayFormat(int16_t x, int16_t y, int16_t w, int16_t align, String content,
                                uint8_t font, uint16_t color, uint16_t bg) = 0;
 
+    virtual bool displayNumber(int16_t x, int16_t y, int16_t w, int32_t value, uint8_t decimals) {
+        // displays with a native number renderer override this in order to avoid the text path
+        char szBuffer[14];
+        char *pDst = szBuffer + sizeof(szBuffer) - 1;
+        uint32_t number = value < 0 ? 0 - (uint32_t)value : value;
+        uint8_t digit = 0;
+        *pDst = 0;
+        do {
+            if (decimals && digit == decimals) {
+                *--pDst = '.';
+            }
+            *--pDst = '0' + number % 10;
+            number /= 10;
+            digit++;
+        } while (number || digit <= decimals);
+        if (value < 0) {
+            *--pDst = '-';
+        }
+        return displayFormat(x, y, w, 2, pDst, current_font, current_fg, current_bg);
+    }
+
+    virtual bool displayReady() {
+        // displays with asynchronous output report here if the last frame was fully transmitted
+        return true;
+    }
+
 #ifdef USTD_FEATURE_PROGRAMPLAYER
     virtual void changedProgramItem(ProgramItem &item) {
         switch (item.mode) {
@@ -943,6 +1049,17 @@ class MuppletDisplay {
             displayFormat(0, program_pos, program_width, 2, item.content, item.font, item.color,
                           item.bg);
             break;
+        case Marquee:
+            if (program_state == FadeIn) {
+                marqueeEnd();
+                if (marqueeBegin(item)) {
+                    break;
+                }
+                program_state = Wait;
+            }
+            displayFormat(0, program_pos, program_width, 0, item.content, item.font, item.color,
+                          item.bg);
+            break;
         case SlideIn:
             if (program_state == FadeIn && charPos < item.content.length() - 1) {
                 int16_t x, y;
@@ -964,6 +1081,10 @@ class MuppletDisplay {
 
     virtual void startProgramItem(ProgramItem &item, int16_t x, int16_t y, int16_t w, int16_t h) {
         item.duration.reset();
+        if (item.mode != Scroll) {
+            // consecutive scroll items share the scrolled area
+            scrollEnd();
+        }
         switch (item.mode) {
         case Left:
             displayFormat(0, program_pos, program_width, 0, item.content, item.font, item.color,
@@ -994,6 +1115,30 @@ class MuppletDisplay {
                 program_state = Wait;
             }
             break;
+        case Marquee:
+            delayCtr = 1;
+            marqueePos = 0;
+            if (marqueeBegin(item)) {
+                program_state = FadeIn;
+            } else {
+                // marquee not supported by the display
+                displayFormat(0, program_pos, program_width, 0, item.content, item.font, item.color,
+                              item.bg);
+                program_state = Wait;
+            }
+            break;
+        case Scroll:
+            delayCtr = 1;
+            marqueePos = 0;
+            if (scrollBegin(item)) {
+                program_state = FadeIn;
+            } else {
+                // vertical scrolling not supported by the display
+                displayFormat(0, program_pos, program_width, 0, item.content, item.font, item.color,
+                              item.bg);
+                program_state = Wait;
+            }
+            break;
         default:
             program_state = Finished;
             break;
@@ -1028,6 +1173,25 @@ class MuppletDisplay {
                     return;
                 }
             }
+        } else if (item.mode == Marquee) {
+            if (--delayCtr) {
+                return;
+            }
+            delayCtr = 17 - item.speed;
+            if (!marqueeStep(item, marqueePos++)) {
+                // the text has left the display
+                marqueeEnd();
+                program_state = Finished;
+            }
+        } else if (item.mode == Scroll) {
+            if (--delayCtr) {
+                return;
+            }
+            delayCtr = 17 - item.speed;
+            if (!scrollStep(item, marqueePos++)) {
+                // the text has fully entered the display
+                fadeInEnd(item, x, y, w, h);
+            }
         } else {
             fadeInEnd(item, x, y, w, h);
             return;
@@ -1080,6 +1244,37 @@ class MuppletDisplay {
 
     virtual bool initNextCharDimensions(ProgramItem &item) = 0;
 
+    virtual bool marqueeBegin(ProgramItem &item) {
+        // displays supporting the marquee mode prepare the content of the item here
+        return false;
+    }
+
+    virtual bool marqueeStep(ProgramItem &item, int16_t pos) {
+        // displays supporting the marquee mode show the marquee scrolled by `pos` pixels here
+        // and report if the content is still visible
+        return false;
+    }
+
+    virtual void marqueeEnd() {
+        // displays supporting the marquee mode release the prepared content here
+    }
+
+    virtual bool scrollBegin(ProgramItem &item) {
+        // displays supporting the scroll mode prepare the scroll area here, if not yet done by a
+        // previous scroll item
+        return false;
+    }
+
+    virtual bool scrollStep(ProgramItem &item, int16_t pos) {
+        // displays supporting the scroll mode scroll up by one pixel row here and draw the row
+        // `pos` of the new text in the exposed row. Returns false when the text is complete
+        return false;
+    }
+
+    virtual void scrollEnd() {
+        // displays supporting the scroll mode restore the unscrolled display here
+    }
+
 #endif
 };
 
@@ -1087,7 +1282,58 @@ const char *MuppletDisplay::formatTokens[] = {"left", "center", "right", "number
 const char *MuppletDisplay::colorTokens[] = {"black", "white",   "red",    "green",  "blue",
                                              "cyan",  "magenta", "yellow", "orange", nullptr};
 
+// sorted by path for the binary search in MuppletDisplay::findCommand()
+const MuppletDisplay::CommandEntry MuppletDisplay::commandTable[] = {
+    {"background/get", BackgroundGet},
+    {"background/set", BackgroundSet},
+    {"cmnd/clear", CmdClear},
+    {"cmnd/format", CmdFormat},
+    {"cmnd/print", CmdPrint},
+    {"cmnd/printat", CmdPrintAt},
+    {"cmnd/println", CmdPrintln},
+    {"color/get", ColorGet},
+    {"color/set", ColorSet},
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    {"content/add", ContentAdd},
+    {"content/clear", ContentClear},
+    {"content/get", ContentGet},
+    {"count/get", CountGet},
+#endif
+    {"cursor/get", CursorGet},
+    {"cursor/set", CursorSet},
+    {"cursor/x/get", CursorXGet},
+    {"cursor/x/set", CursorXSet},
+    {"cursor/y/get", CursorYGet},
+    {"cursor/y/set", CursorYSet},
+#ifdef USTD_FEATURE_PROGRAMPLAYER
+    {"default/background/get", DefaultBackgroundGet},
+    {"default/background/set", DefaultBackgroundSet},
+    {"default/color/get", DefaultColorGet},
+    {"default/color/set", DefaultColorSet},
+    {"default/duration/get", DefaultDurationGet},
+    {"default/duration/set", DefaultDurationSet},
+    {"default/font/get", DefaultFontGet},
+    {"default/font/set", DefaultFontSet},
+    {"default/get", DefaultGet},
+    {"default/mode/get", DefaultModeGet},
+    {"default/mode/set", DefaultModeSet},
+    {"default/repeat/get", DefaultRepeatGet},
+    {"default/repeat/set", DefaultRepeatSet},
+    {"default/set", DefaultSet},
+    {"default/speed/get", DefaultSpeedGet},
+    {"default/speed/set", DefaultSpeedSet},
+    {"items/add", ItemsAdd},
+    {"items/clear", ItemsClear},
+    {"items/get", ItemsGet},
+#endif
+    {"wrap/get", WrapGet},
+    {"wrap/set", WrapSet},
+};
+const uint8_t MuppletDisplay::commandTableSize =
+    sizeof(MuppletDisplay::commandTable) / sizeof(MuppletDisplay::commandTable[0]);
+
 #ifdef USTD_FEATURE_PROGRAMPLAYER
-const char *MuppletDisplay::modeTokens[] = {"left", "center", "right", "slidein", nullptr};
+const char *MuppletDisplay::modeTokens[] = {"left",    "center",  "right", "slidein",
+                                            "marquee", "scroll",  nullptr};
 #endif
 }  // namespace ustd
\ No newline at end of file
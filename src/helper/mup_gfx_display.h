@@ -100,28 +100,27 @@ class MuppletGfxDisplay : public MuppletDisplay {
 #endif  //__AVR__
     }
 
-    virtual bool commandParser(String command, String args, String topic) {
-        if (MuppletDisplay::commandParser(command, args, topic)) {
+    virtual bool commandParser(const char *command, String &args) {
+        if (MuppletDisplay::commandParser(command, args)) {
             return true;
-        } else if (command.startsWith("font/")) {
-            return fontParser(command.substring(5), args, topic + "/font");
+        } else if (!strcmp(command, "font/get")) {
+            return fontParser(false, args);
+        } else if (!strcmp(command, "font/set")) {
+            return fontParser(true, args);
         }
         return false;
     }
 
-    bool fontParser(String command, String args, String topic) {
-        if (command == "get") {
-            pSched->publish(topic, String(current_font));
-            return true;
-        } else if (command == "set") {
+    bool fontParser(bool set, String &args) {
+        if (set) {
             long font = parseRangedLong(args, 0, fonts.length() - 1, -1, -1);
-            if (font >= 0) {
-                setfont(font);
-                pSched->publish(topic, String(current_font));
-                return true;
+            if (font < 0) {
+                return false;
             }
+            setfont(font);
         }
-        return false;
+        pSched->publish(name + "/display/font", String(current_font));
+        return true;
     }
 
     // abstract methods implementation
@@ -6,6 +6,7 @@
 #include <Adafruit_ST7789.h>
 #include <Adafruit_SSD1306.h>
 #include "jsonfile.h"
+#include "helper/indexed_canvas.h"
 
 ustd::jsonfile jf;
 
@@ -27,11 +28,16 @@ class GfxDrivers {
     BusType busType;
     bool validDisplay;
     bool useCanvas;
+    uint8_t canvasBits;
     bool hasBegun;
     Adafruit_ST7735 *pDisplayST;
     Adafruit_ST7789 *pDisplayST9;
     Adafruit_SSD1306 *pDisplaySSD;
-    GFXcanvas16 *pCanvas;
+    Adafruit_GFX *pCanvas;
+    GFXcanvas16 *pCanvas16;
+    IndexedCanvas *pIndexedCanvas;
+    uint8_t themeColorCount;
+    bool themeAmbiguous;
 
     GfxDrivers(String name, DisplayType displayType, uint16_t resX, uint16_t resY,
                uint8_t i2cAddress, TwoWire *pWire = &Wire)
@@ -41,6 +47,10 @@ class GfxDrivers {
         pDisplayST9 = nullptr;
         pDisplaySSD = nullptr;
         pCanvas = nullptr;
+        pCanvas16 = nullptr;
+        pIndexedCanvas = nullptr;
+        themeColorCount = 0;
+        themeAmbiguous = false;
         hasBegun = false;
         if (displayType == DisplayType::SSD1306) {
             validDisplay = true;
@@ -59,6 +69,10 @@ class GfxDrivers {
         pDisplayST9 = nullptr;
         pDisplaySSD = nullptr;
         pCanvas = nullptr;
+        pCanvas16 = nullptr;
+        pIndexedCanvas = nullptr;
+        themeColorCount = 0;
+        themeAmbiguous = false;
         hasBegun = false;
         if (displayType == DisplayType::ST7735 || displayType == DisplayType::ST7789) {
             validDisplay = true;
@@ -72,10 +86,15 @@ class GfxDrivers {
     ~GfxDrivers() {  // undefined behavior for delete display objects.
     }
 
-    void begin(bool _useCanvas = false) {
+    void begin(bool _useCanvas = false, uint8_t _canvasBits = 16) {
         /*! Initialize the display.
-         * Note: Using canvas uses a lot of memory! Use with ESP32 or better kind of chips.
+         * Note: Using a RGB565 canvas uses a lot of memory (40 KB for 160x128)! Use with ESP32 or
+         * better kind of chips. A palette based canvas with 4 bits per pixel needs only 10 KB and
+         * is also usable on ESP8266. If the canvas cannot be allocated, the display is used
+         * directly.
          *  @param _useCanvas If true, use a canvas for drawing. If false, use the display directly.
+         *  @param _canvasBits Bits per pixel of the canvas of color displays: 16 (RGB565), 8 (256
+         *  colors palette) or 4 (16 colors palette).
          */
         if (hasBegun) {
 #ifdef USE_SERIAL_DBG
@@ -85,6 +104,7 @@ class GfxDrivers {
         }
         hasBegun = true;
         useCanvas = _useCanvas;
+        canvasBits = _canvasBits;
         if (validDisplay) {
             switch (displayType) {
             case DisplayType::SSD1306:
@@ -113,7 +133,9 @@ class GfxDrivers {
                     return;
                 }
                 if (useCanvas) {
-                    pCanvas = new GFXcanvas16(resX, resY);
+                    useCanvas = createCanvas();
+                }
+                if (useCanvas) {
                     pCanvas->setTextWrap(false);
                     pCanvas->fillScreen(ST77XX_BLACK);
                     pCanvas->cp437(true);
@@ -143,7 +165,9 @@ class GfxDrivers {
                     return;
                 }
                 if (useCanvas) {
-                    pCanvas = new GFXcanvas16(resX, resY);
+                    useCanvas = createCanvas();
+                }
+                if (useCanvas) {
                     pCanvas->setTextWrap(false);
                     pCanvas->fillScreen(ST77XX_BLACK);
                     pCanvas->cp437(true);
@@ -159,6 +183,61 @@ class GfxDrivers {
         }
     }
 
+    bool createCanvas() {
+        if (canvasBits == 4 || canvasBits == 8) {
+            pIndexedCanvas = new IndexedCanvas(resX, resY, canvasBits);
+            if (pIndexedCanvas->getBuffer() == nullptr) {
+                delete pIndexedCanvas;
+                pIndexedCanvas = nullptr;
+            }
+            pCanvas = pIndexedCanvas;
+        } else {
+            pCanvas16 = new GFXcanvas16(resX, resY);
+            if (pCanvas16->getBuffer() == nullptr) {
+                delete pCanvas16;
+                pCanvas16 = nullptr;
+            }
+            pCanvas = pCanvas16;
+        }
+#ifdef USE_SERIAL_DBG
+        if (pCanvas == nullptr) {
+            Serial.println("ERROR GfxDrivers::begin() - could not allocate canvas, using display");
+        }
+#endif
+        return pCanvas != nullptr;
+    }
+
+    bool setThemeColors(const uint32_t *pColors, uint8_t count) {
+        /*! Register the colors of a theme in the palette of an indexed canvas.
+         * The theme colors occupy the first palette entries. Changing the theme colors rewrites
+         * these entries, which recolors all pixels drawn with the previous theme colors.
+         * @param pColors Array of the theme colors (24 bit RGB)
+         * @param count Number of theme colors
+         * @return true, if the content of the canvas has been recolored by the palette rewrite,
+         * false if the content needs to be redrawn (no indexed canvas, first registration or
+         * several theme colors mapping to the same palette color).
+         */
+        if (pIndexedCanvas == nullptr) {
+            return false;
+        }
+        bool ambiguous = false;
+        for (uint8_t i = 0; i < count && !ambiguous; i++) {
+            for (uint8_t j = 0; j < i; j++) {
+                if (rgbColor(pColors[i]) == rgbColor(pColors[j])) {
+                    ambiguous = true;
+                    break;
+                }
+            }
+        }
+        bool recolored = themeColorCount == count && !themeAmbiguous && !ambiguous;
+        for (uint8_t i = 0; i < count; i++) {
+            pIndexedCanvas->setPaletteColor(i, rgbColor(pColors[i]));
+        }
+        themeColorCount = count;
+        themeAmbiguous = ambiguous;
+        return recolored;
+    }
+
     void setBGColor(uint32_t _bgColor) {
         uint8_t r, g, b;
         splitRGB(_bgColor, &r, &g, &b);
@@ -218,17 +297,17 @@ class GfxDrivers {
                 break;
             case DisplayType::ST7735:
                 if (useCanvas) {
-                    pCanvas->fillScreen(bgColor);
+                    pCanvas->fillScreen(rgbColor(bgColor));
                 } else {
-                    pDisplayST->fillScreen(bgColor);
+                    pDisplayST->fillScreen(rgbColor(bgColor));
                 }
                 break;
             case DisplayType::ST7789:
                 if (useCanvas) {
-                    pCanvas->fillScreen(bgColor);
+                    pCanvas->fillScreen(rgbColor(bgColor));
                 } else {
                     if (pDisplayST9) {
-                        pDisplayST9->fillScreen(bgColor);
+                        pDisplayST9->fillScreen(rgbColor(bgColor));
                     }
                 }
                 break;
@@ -451,14 +530,19 @@ class GfxDrivers {
                 pDisplaySSD->display();
                 break;
             case DisplayType::ST7735:
-                if (useCanvas) {
-                    pDisplayST->drawRGBBitmap(0, 0, pCanvas->getBuffer(), resX, resY);
+                if (pIndexedCanvas) {
+                    pIndexedCanvas->drawTo(pDisplayST);
+                } else if (pCanvas16) {
+                    pDisplayST->drawRGBBitmap(0, 0, pCanvas16->getBuffer(), resX, resY);
                 }
                 break;
             case DisplayType::ST7789:
-                if (useCanvas) {
-                    if (pDisplayST9)
-                        pDisplayST9->drawRGBBitmap(0, 0, pCanvas->getBuffer(), resX, resY);
+                if (pDisplayST9) {
+                    if (pIndexedCanvas) {
+                        pIndexedCanvas->drawTo(pDisplayST9);
+                    } else if (pCanvas16) {
+                        pDisplayST9->drawRGBBitmap(0, 0, pCanvas16->getBuffer(), resX, resY);
+                    }
                 }
                 break;
             default:
@@ -581,6 +665,7 @@ class GfxPanel {
     uint8_t csPin, dcPin, rstPin;
     String locale;
     bool active;
+    uint8_t canvasBits;
 
     GfxDrivers *pDisplay;
     ustd::Scheduler *pSched;
@@ -743,7 +828,7 @@ class GfxPanel {
     float brightness, contrast;
     enum Theme { ThemeDark, ThemeLight, ThemeGruvbox, ThemeSolarizedDark, ThemeSolarizedLight };
     Theme themeType;
-    void _setTheme(Theme theme) {
+    bool _setTheme(Theme theme) {
         themeType = Theme::ThemeDark;
         switch (theme) {
         case ThemeLight:
@@ -789,10 +874,25 @@ class GfxPanel {
 #ifdef USE_SERIAL_DBG
         Serial.println("setTheme: " + themeName);
 #endif
+        // with a palette canvas, the theme colors are the first palette entries
+        uint32_t themeColors[] = {defaultColor,       defaultBgColor,       defaultSeparatorColor,
+                                  defaultAccentColor, defaultIncreaseColor, defaultConstColor,
+                                  defaultDecreaseColor};
+        return pDisplay->setThemeColors(themeColors, sizeof(themeColors) / sizeof(uint32_t));
+    }
+
+    void _refreshTheme(bool recolored) {
+        if (recolored) {
+            // palette rewrite recolored the canvas, only transmit it
+            pDisplay->display();
+        } else {
+            updateDisplay(true, true);
+        }
     }
 
     void _common_init() {
         active = false;
+        canvasBits = 16;
         displayFrameRateMs = 1000;
         slotResX = 64;
         slotResY = 32;
@@ -1063,7 +1163,7 @@ class GfxPanel {
     }
 
     void commonBegin(bool useCanvas = false) {
-        pDisplay->begin(useCanvas);
+        pDisplay->begin(useCanvas, canvasBits);
 
         auto fntsk = [=]() { _sensorLoop(); };
         minUpdateIntervalMs = 50;
@@ -1120,6 +1220,17 @@ class GfxPanel {
     }
 
   public:
+    void setCanvasBits(uint8_t _canvasBits = 16) {
+        /*! Select the color depth of the canvas of color displays, must be called before begin()
+
+        @param _canvasBits 16 for a RGB565 canvas, 8 or 4 for a palette based canvas with 256 or 16
+        colors. A 160x128 canvas needs 40 KB, 20 KB or 10 KB. With a palette based canvas,
+        brightness, contrast and theme changes only rewrite the palette instead of redrawing all
+        slots.
+        */
+        canvasBits = _canvasBits;
+    }
+
     void setBrightness(float _brightness = 0.5) {
         if (!active)
             return;
@@ -1128,8 +1239,7 @@ class GfxPanel {
         if (_brightness > 1.0)
             _brightness = 1.0;
         brightness = _brightness;
-        _setTheme(themeType);
-        updateDisplay(true, true);
+        _refreshTheme(_setTheme(themeType));
     }
 
     void publishBrightness() {
@@ -1146,8 +1256,7 @@ class GfxPanel {
         if (_contrast > 1.0)
             _contrast = 1.0;
         contrast = _contrast;
-        _setTheme(themeType);
-        updateDisplay(true, true);
+        _refreshTheme(_setTheme(themeType));
     }
 
     void publishContrast() {
@@ -1160,20 +1269,21 @@ class GfxPanel {
         if (!active)
             return;
         bool upd = false;
+        bool recolored = false;
         contrast = 0.5;
         brightness = 0.5;
         if (_theme == "light") {
-            _setTheme(Theme::ThemeLight);
+            recolored = _setTheme(Theme::ThemeLight);
             upd = true;
         }
         if (_theme == "solarizedlight") {
-            _setTheme(Theme::ThemeSolarizedLight);
+            recolored = _setTheme(Theme::ThemeSolarizedLight);
             upd = true;
         }
         if (!upd) {
-            _setTheme(Theme::ThemeDark);
+            recolored = _setTheme(Theme::ThemeDark);
         }
-        updateDisplay(true, true);
+        _refreshTheme(recolored);
     }
 
     void publishTheme() {
@@ -8,6 +8,8 @@
 
 mupplet-display implements the following classes based on the cooperative scheduler muwerk:
 
+* * \ref ustd::DisplayDigitsMAX72XX
+* * \ref ustd::DisplayDigitsHT162X
 * * \ref ustd::DisplayMatrixMAX72XX
 
 Additionally there are implementation for the following hardware driver classes:
@@ -15,6 +17,8 @@ Additionally there are implementation for the following hardware driver classes:
 * * \ref ustd::Max72XX
 * * \ref ustd::Max72xxMatrix
 * * \ref ustd::Max72xxDigits
+* * \ref ustd::Ht162X
+* * \ref ustd::Ht162xDigits
 
 Sensor value display and plot:
 